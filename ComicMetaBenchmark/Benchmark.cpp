@@ -0,0 +1,110 @@
+﻿/*! \file
+ *  \brief ベンチマークの計測用クラス 実装部
+ *  \date 2026/10/17 新規作成
+ */
+
+#include "Benchmark.h"
+#include <QElapsedTimer>
+#include <iostream>
+
+using namespace std;
+
+QJsonObject Benchmark::parameters() const
+{
+    return QJsonObject();
+}
+
+qint64 Benchmark::bytesPerIteration() const
+{
+    return 0;
+}
+
+BenchmarkRunner::BenchmarkRunner()
+{
+    _minimumTimeNs = 200 * 1000000LL;
+    _repeatCount = 3;
+}
+
+BenchmarkRunner::~BenchmarkRunner()
+{
+    qDeleteAll(_benchmarks);
+}
+
+void BenchmarkRunner::setMinimumTime(int milliseconds)
+{
+    if(milliseconds > 0) _minimumTimeNs = milliseconds * 1000000LL;
+}
+
+void BenchmarkRunner::setRepeatCount(int count)
+{
+    if(count > 0) _repeatCount = count;
+}
+
+void BenchmarkRunner::setFilter(QString filter)
+{
+    _filter = filter;
+}
+
+void BenchmarkRunner::add(Benchmark *benchmark)
+{
+    _benchmarks.push_back(benchmark);
+}
+
+QJsonArray BenchmarkRunner::runAll()
+{
+    QJsonArray results;
+    for(int i=0; i<_benchmarks.size(); i++){
+        if(!_filter.isEmpty() && !_benchmarks.at(i)->name().contains(_filter)) continue;
+        results.append(runOne(_benchmarks.at(i)));
+    }
+    return results;
+}
+
+QJsonObject BenchmarkRunner::runOne(Benchmark *benchmark)
+{
+    benchmark->setUp();
+
+    //!ウォームアップを兼ねて、最小計測時間を超える繰り返し回数を求める
+    QElapsedTimer timer;
+    int iterations = 1;
+    qint64 elapsed = 0;
+    forever{
+        timer.start();
+        benchmark->run(iterations);
+        elapsed = timer.nsecsElapsed();
+        if(elapsed >= _minimumTimeNs || iterations >= (1 << 30)) break;
+        iterations *= 2;
+    }
+
+    //!同じ回数で計測を繰り返し、最速値を採用する
+    qint64 best = elapsed;
+    for(int i=1; i<_repeatCount; i++){
+        timer.start();
+        benchmark->run(iterations);
+        best = qMin(best, timer.nsecsElapsed());
+    }
+
+    double nsPerOp = double(best) / iterations;
+    QJsonObject result;
+    result.insert("name", benchmark->name());
+    result.insert("parameters", benchmark->parameters());
+    result.insert("iterations", iterations);
+    result.insert("total_ns", double(best));
+    result.insert("ns_per_op", nsPerOp);
+    result.insert("ops_per_s", nsPerOp > 0 ? 1e9 / nsPerOp : 0.0);
+    qint64 bytes = benchmark->bytesPerIteration();
+    if(bytes > 0){
+        result.insert("bytes_per_op", double(bytes));
+        result.insert("mb_per_s", nsPerOp > 0 ? (bytes / (1024.0 * 1024.0)) * 1e9 / nsPerOp : 0.0);
+    }
+
+    //!進捗を標準エラー出力に表示する（標準出力はJSON用）
+    QString params;
+    QJsonObject parameters = benchmark->parameters();
+    for(QJsonObject::const_iterator it = parameters.constBegin(); it != parameters.constEnd(); ++it){
+        params += QString(" %1=%2").arg(it.key()).arg(it.value().toVariant().toString());
+    }
+    cerr << benchmark->name().toStdString() << params.toStdString()
+         << " : " << nsPerOp << " ns/op (" << iterations << " iterations)" << endl;
+    return result;
+}
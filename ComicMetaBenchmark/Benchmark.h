@@ -0,0 +1,58 @@
+﻿/*! \file
+ *  \brief ベンチマークの計測用クラス
+ *  \date 2026/10/17 新規作成
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <QString>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QList>
+
+/*!
+ * \brief ベンチマーク1件分の基底クラス
+ * setUp()で入力データを準備し、run()で指定回数だけ計測対象の処理を実行する
+ */
+class Benchmark
+{
+public:
+    virtual ~Benchmark() {}
+    virtual QString name() const = 0; //!< ベンチマーク名（例: "writeMetadata_Page"）
+    virtual QJsonObject parameters() const; //!< 入力条件（注釈数等）
+    virtual void setUp() {} //!< 入力データの準備（計測対象外）
+    virtual void run(int iterations) = 0; //!< 計測対象の処理をiterations回実行する
+    virtual qint64 bytesPerIteration() const; //!< 1回あたりの処理バイト数（無ければ0）
+};
+
+/*!
+ * \brief ベンチマークを実行し、結果をJSONにまとめるクラス
+ * 1回の計測時間が最小計測時間を超えるまで繰り返し回数を倍増させ、
+ * 同じ回数での計測を指定回数行ったうちの最速値を結果とする
+ */
+class BenchmarkRunner
+{
+public:
+    BenchmarkRunner();
+    ~BenchmarkRunner(); //!< 登録されたベンチマークを破棄する
+
+    void setMinimumTime(int milliseconds); //!< 1回の計測の最小時間
+    void setRepeatCount(int count); //!< 計測の繰り返し回数
+    void setFilter(QString filter); //!< 名前にこの文字列を含むものだけ実行する
+
+    //! ベンチマークを登録する（所有権は本クラスに移る）
+    void add(Benchmark *benchmark);
+
+    //! 登録されたベンチマークを実行し、結果を返す
+    QJsonArray runAll();
+
+private:
+    QJsonObject runOne(Benchmark *benchmark);
+    QList<Benchmark*> _benchmarks;
+    qint64 _minimumTimeNs;
+    int _repeatCount;
+    QString _filter;
+};
+
+#endif // BENCHMARK_H
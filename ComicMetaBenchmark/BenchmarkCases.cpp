@@ -0,0 +1,445 @@
+﻿/*! \file
+ *  \brief 各ベンチマークの定義 実装部
+ *  \date 2026/10/17 新規作成
+ */
+
+#include "BenchmarkCases.h"
+#include "CommonFunction.h"
+#include "GraphicsItemData.h"
+#include "SyntheticMetadata.h"
+#include <QBuffer>
+
+namespace {
+
+const int PAGE_WIDTH = 1500; //!< 生成するページの画像幅
+const int PAGE_HEIGHT = 1060; //!< 生成するページの画像高さ
+const unsigned int RANDOM_SEED = 20261017; //!< 入力データ生成用の乱数シード（結果を再現できるよう固定）
+const int SAMPLE_COUNT = 1024; //!< 座標計算系ベンチマークで1回に処理するデータ数
+
+//! 計算結果を捨てられないようにするための書き込み先
+volatile double g_sink = 0;
+
+//入力データはSyntheticMetadataの乱数生成器で作り、標準ライブラリによらず同じ内容とする
+//（関数引数の評価順は未規定のため、乱数を使う式は1文ずつ分けて評価する）
+
+/*!
+ * \brief ページ内のランダムな位置に凸ポリゴンを生成する
+ * \param random 乱数生成器
+ * \param vertexCount 頂点数（3以上）
+ * \return ポリゴン
+ */
+QPolygonF createPolygon(SyntheticRandom &random, int vertexCount)
+{
+    QRectF bounds = createSyntheticRect(random, QRectF(0, 0, PAGE_WIDTH, PAGE_HEIGHT), 0.05, 0.3);
+    return createSyntheticPolygon(random, bounds, vertexCount);
+}
+
+/*!
+ * \brief ページ内のランダムな点を生成する
+ * \param random 乱数生成器
+ * \return 点
+ */
+QPointF createPoint(SyntheticRandom &random)
+{
+    double x = random.real(0, PAGE_WIDTH);
+    double y = random.real(0, PAGE_HEIGHT);
+    return QPointF(x, y);
+}
+
+QJsonObject annotationParameter(int annotationCount)
+{
+    QJsonObject param;
+    param.insert("annotations", annotationCount);
+    return param;
+}
+
+QJsonObject vertexParameter(int vertexCount)
+{
+    QJsonObject param;
+    param.insert("vertices", vertexCount);
+    param.insert("polygons", SAMPLE_COUNT);
+    return param;
+}
+
+} // namespace
+
+/*!
+ * \brief 指定した数の注釈を持つページメタデータを生成する
+ * \param metadata 生成先
+ * \param annotationCount 注釈の総数（各種類に均等に振り分ける）
+ */
+static void createBenchmarkPage(ComicMetadata &metadata, int annotationCount)
+{
+    SyntheticPageSpec spec;
+    spec.imageWidth = PAGE_WIDTH;
+    spec.imageHeight = PAGE_HEIGHT;
+    spec.setAnnotationCount(annotationCount);
+    createSyntheticCommon(metadata, "Benchmark", 8);
+    createSyntheticPage(metadata, spec, 1, 1, RANDOM_SEED);
+}
+
+/*
+ * WritePageBenchmark
+ */
+WritePageBenchmark::WritePageBenchmark(int annotationCount)
+{
+    _annotationCount = annotationCount;
+    _bytes = 0;
+}
+
+QString WritePageBenchmark::name() const
+{
+    return "writeMetadata_Page";
+}
+
+QJsonObject WritePageBenchmark::parameters() const
+{
+    return annotationParameter(_annotationCount);
+}
+
+void WritePageBenchmark::setUp()
+{
+    createBenchmarkPage(_metadata, _annotationCount);
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    _metadata.writeMetadata_Page(&buffer);
+    _bytes = buffer.size();
+}
+
+void WritePageBenchmark::run(int iterations)
+{
+    QByteArray xml;
+    xml.reserve(int(_bytes) + 1024);
+    for(int i=0; i<iterations; i++){
+        xml.resize(0);
+        QBuffer buffer(&xml);
+        buffer.open(QIODevice::WriteOnly);
+        _metadata.writeMetadata_Page(&buffer);
+    }
+    g_sink = xml.size();
+}
+
+qint64 WritePageBenchmark::bytesPerIteration() const
+{
+    return _bytes;
+}
+
+/*
+ * LoadPageBenchmark
+ */
+LoadPageBenchmark::LoadPageBenchmark(int annotationCount)
+{
+    _annotationCount = annotationCount;
+}
+
+QString LoadPageBenchmark::name() const
+{
+    return "loadMetadata_Page";
+}
+
+QJsonObject LoadPageBenchmark::parameters() const
+{
+    return annotationParameter(_annotationCount);
+}
+
+void LoadPageBenchmark::setUp()
+{
+    ComicMetadata source;
+    createBenchmarkPage(source, _annotationCount);
+    QBuffer buffer(&_xml);
+    buffer.open(QIODevice::WriteOnly);
+    source.writeMetadata_Page(&buffer);
+}
+
+void LoadPageBenchmark::run(int iterations)
+{
+    for(int i=0; i<iterations; i++){
+        QBuffer buffer(&_xml);
+        buffer.open(QIODevice::ReadOnly);
+        _metadata.loadMetadata_Page(&buffer);
+    }
+    g_sink = _metadata.loadDialog.size();
+}
+
+qint64 LoadPageBenchmark::bytesPerIteration() const
+{
+    return _xml.size();
+}
+
+/*
+ * PolygonAreaBenchmark
+ */
+PolygonAreaBenchmark::PolygonAreaBenchmark(int vertexCount)
+{
+    _vertexCount = vertexCount;
+}
+
+QString PolygonAreaBenchmark::name() const
+{
+    return "calcPolygonAreaSize";
+}
+
+QJsonObject PolygonAreaBenchmark::parameters() const
+{
+    return vertexParameter(_vertexCount);
+}
+
+void PolygonAreaBenchmark::setUp()
+{
+    SyntheticRandom random(RANDOM_SEED);
+    _polygons.clear();
+    for(int i=0; i<SAMPLE_COUNT; i++){
+        _polygons.push_back(createPolygon(random, _vertexCount));
+    }
+}
+
+void PolygonAreaBenchmark::run(int iterations)
+{
+    double sum = 0;
+    for(int i=0; i<iterations; i++){
+        sum += calcPolygonAreaSize(_polygons.at(i % SAMPLE_COUNT));
+    }
+    g_sink = sum;
+}
+
+/*
+ * PolygonAreaBatchBenchmark
+ */
+PolygonAreaBatchBenchmark::PolygonAreaBatchBenchmark(int vertexCount)
+{
+    _vertexCount = vertexCount;
+}
+
+QString PolygonAreaBatchBenchmark::name() const
+{
+    return "calcPolygonAreaSizes";
+}
+
+QJsonObject PolygonAreaBatchBenchmark::parameters() const
+{
+    return vertexParameter(_vertexCount);
+}
+
+void PolygonAreaBatchBenchmark::setUp()
+{
+    SyntheticRandom random(RANDOM_SEED);
+    _points.clear();
+    _offsets.clear();
+    for(int i=0; i<SAMPLE_COUNT; i++){
+        _offsets.push_back(_points.size());
+        _points += createPolygon(random, _vertexCount);
+    }
+    _offsets.push_back(_points.size());
+    _areaSize.fill(0, SAMPLE_COUNT);
+}
+
+void PolygonAreaBatchBenchmark::run(int iterations)
+{
+    double sum = 0;
+    for(int done=0; done<iterations; done+=SAMPLE_COUNT){
+        int count = qMin(SAMPLE_COUNT, iterations - done);
+        calcPolygonAreaSizes(_points.constData(), _offsets.constData(), count, _areaSize.data());
+        sum += _areaSize.at(count - 1);
+    }
+    g_sink = sum;
+}
+
+/*
+ * DistanceBenchmark
+ */
+QString DistanceBenchmark::name() const
+{
+    return "getDistance";
+}
+
+void DistanceBenchmark::setUp()
+{
+    SyntheticRandom random(RANDOM_SEED);
+    _lines.clear();
+    _points.clear();
+    for(int i=0; i<SAMPLE_COUNT; i++){
+        QPointF from = createPoint(random);
+        QPointF to = createPoint(random);
+        _lines.push_back(QLineF(from, to));
+        _points.push_back(createPoint(random));
+    }
+}
+
+void DistanceBenchmark::run(int iterations)
+{
+    double sum = 0;
+    for(int i=0; i<iterations; i++){
+        sum += getDistance(_lines.at(i % SAMPLE_COUNT), _points.at(i % SAMPLE_COUNT));
+    }
+    g_sink = sum;
+}
+
+/*
+ * NearestEdgeBenchmark
+ */
+NearestEdgeBenchmark::NearestEdgeBenchmark(int vertexCount)
+{
+    _vertexCount = vertexCount;
+}
+
+QString NearestEdgeBenchmark::name() const
+{
+    return "findNearestEdge";
+}
+
+QJsonObject NearestEdgeBenchmark::parameters() const
+{
+    return vertexParameter(_vertexCount);
+}
+
+void NearestEdgeBenchmark::setUp()
+{
+    SyntheticRandom random(RANDOM_SEED);
+    _polygons.clear();
+    _points.clear();
+    for(int i=0; i<SAMPLE_COUNT; i++){
+        _polygons.push_back(createPolygon(random, _vertexCount));
+        _points.push_back(createPoint(random));
+    }
+}
+
+void NearestEdgeBenchmark::run(int iterations)
+{
+    double sum = 0;
+    for(int i=0; i<iterations; i++){
+        const QPolygonF &polygon = _polygons.at(i % SAMPLE_COUNT);
+        double distance = 0;
+        sum += findNearestEdge(polygon.constData(), polygon.size(), _points.at(i % SAMPLE_COUNT), &distance);
+        sum += distance;
+    }
+    g_sink = sum;
+}
+
+/*
+ * PositionConversionBenchmark
+ */
+PositionConversionBenchmark::PositionConversionBenchmark(int vertexCount)
+{
+    _vertexCount = vertexCount;
+}
+
+QString PositionConversionBenchmark::name() const
+{
+    return "calcRelativePosition+calcAbsolutePosition";
+}
+
+QJsonObject PositionConversionBenchmark::parameters() const
+{
+    return vertexParameter(_vertexCount);
+}
+
+void PositionConversionBenchmark::setUp()
+{
+    SyntheticRandom random(RANDOM_SEED);
+    _polygons.clear();
+    for(int i=0; i<SAMPLE_COUNT; i++){
+        _polygons.push_back(createPolygon(random, _vertexCount));
+    }
+}
+
+void PositionConversionBenchmark::run(int iterations)
+{
+    double sum = 0;
+    for(int i=0; i<iterations; i++){
+        QPolygonF relative = calcRelativePosition(_polygons.at(i % SAMPLE_COUNT), PAGE_WIDTH, PAGE_HEIGHT);
+        QPolygonF absolute = calcAbsolutePosition(relative, PAGE_WIDTH, PAGE_HEIGHT);
+        sum += absolute.first().x();
+    }
+    g_sink = sum;
+}
+
+/*
+ * SelectItemBenchmark
+ */
+SelectItemBenchmark::SelectItemBenchmark(int polygonCount)
+{
+    _polygonCount = polygonCount;
+}
+
+QString SelectItemBenchmark::name() const
+{
+    return "selectItem";
+}
+
+QJsonObject SelectItemBenchmark::parameters() const
+{
+    QJsonObject param;
+    param.insert("polygons", _polygonCount);
+    return param;
+}
+
+void SelectItemBenchmark::setUp()
+{
+    SyntheticRandom random(RANDOM_SEED);
+    _polygons.clear();
+    _areaSize.clear();
+    _clickPoints.clear();
+    for(int i=0; i<_polygonCount; i++){
+        int vertexCount = random.integer(4, 8);
+        QPolygonF relative = calcRelativePosition(createPolygon(random, vertexCount), PAGE_WIDTH, PAGE_HEIGHT);
+        //!選択モード開始時と同じく、相対座標から表示用の座標と面積を求めておく
+        QPolygonF polygon = calcAbsolutePosition(relative, PAGE_WIDTH, PAGE_HEIGHT);
+        _polygons.push_back(polygon);
+        _areaSize.push_back(calcPolygonAreaSize(polygon));
+    }
+    for(int i=0; i<SAMPLE_COUNT; i++){
+        _clickPoints.push_back(createPoint(random));
+    }
+}
+
+void SelectItemBenchmark::run(int iterations)
+{
+    int hit = 0;
+    for(int i=0; i<iterations; i++){
+        QPointF mouse = _clickPoints.at(i % SAMPLE_COUNT);
+
+        //!クリック位置を含むポリゴンのうち、面積が最小のものを選ぶ
+        int selected = -1;
+        double minSize = 0;
+        for(int j=0; j<_polygons.size(); j++){
+            if(!_polygons.at(j).containsPoint(mouse, Qt::WindingFill)) continue;
+            if(selected < 0 || _areaSize.at(j) < minSize){
+                selected = j;
+                minSize = _areaSize.at(j);
+            }
+        }
+        if(selected >= 0) hit++;
+    }
+    g_sink = hit;
+}
+
+/*
+ * SelectItemIndexBenchmark
+ */
+SelectItemIndexBenchmark::SelectItemIndexBenchmark(int polygonCount) :
+    SelectItemBenchmark(polygonCount)
+{
+}
+
+QString SelectItemIndexBenchmark::name() const
+{
+    return "PolygonGridIndex::smallestContaining";
+}
+
+void SelectItemIndexBenchmark::setUp()
+{
+    SelectItemBenchmark::setUp();
+    _index.clear();
+    for(int i=0; i<_polygons.size(); i++){
+        _index.append(_polygons.at(i));
+    }
+}
+
+void SelectItemIndexBenchmark::run(int iterations)
+{
+    int hit = 0;
+    for(int i=0; i<iterations; i++){
+        if(_index.smallestContaining(_clickPoints.at(i % SAMPLE_COUNT)) >= 0) hit++;
+    }
+    g_sink = hit;
+}
@@ -0,0 +1,172 @@
+﻿/*! \file
+ *  \brief 各ベンチマークの定義
+ *  \date 2026/10/17 新規作成
+ */
+
+#ifndef BENCHMARKCASES_H
+#define BENCHMARKCASES_H
+
+#include "Benchmark.h"
+#include "ComicMetadata.h"
+#include "PolygonGridIndex.h"
+#include <QByteArray>
+#include <QVector>
+#include <QPolygonF>
+#include <QLineF>
+
+/*!
+ * \brief ページメタデータの出力（writeMetadata_Page）
+ * 指定した数の注釈を持つページをメモリ上のバッファへ出力する。
+ * ディスクの速度に左右されないよう、ファイルへの書き込みは含めない
+ */
+class WritePageBenchmark : public Benchmark
+{
+public:
+    explicit WritePageBenchmark(int annotationCount);
+    QString name() const;
+    QJsonObject parameters() const;
+    void setUp();
+    void run(int iterations);
+    qint64 bytesPerIteration() const;
+private:
+    int _annotationCount;
+    ComicMetadata _metadata;
+    qint64 _bytes;
+};
+
+/*!
+ * \brief ページメタデータの読み込み（loadMetadata_Page）
+ * WritePageBenchmarkと同じページを出力したXMLを、メモリ上のバッファから読み込む
+ */
+class LoadPageBenchmark : public Benchmark
+{
+public:
+    explicit LoadPageBenchmark(int annotationCount);
+    QString name() const;
+    QJsonObject parameters() const;
+    void setUp();
+    void run(int iterations);
+    qint64 bytesPerIteration() const;
+private:
+    int _annotationCount;
+    ComicMetadata _metadata;
+    QByteArray _xml;
+};
+
+/*!
+ * \brief ポリゴンの面積計算（calcPolygonAreaSize）
+ */
+class PolygonAreaBenchmark : public Benchmark
+{
+public:
+    explicit PolygonAreaBenchmark(int vertexCount);
+    QString name() const;
+    QJsonObject parameters() const;
+    void setUp();
+    void run(int iterations);
+private:
+    int _vertexCount;
+    QVector<QPolygonF> _polygons;
+};
+
+/*!
+ * \brief 複数ポリゴンの面積の一括計算（calcPolygonAreaSizes）
+ * 1回の処理はポリゴン1つ分として数えるため、PolygonAreaBenchmarkと直接比較できる
+ */
+class PolygonAreaBatchBenchmark : public Benchmark
+{
+public:
+    explicit PolygonAreaBatchBenchmark(int vertexCount);
+    QString name() const;
+    QJsonObject parameters() const;
+    void setUp();
+    void run(int iterations);
+private:
+    int _vertexCount;
+    QVector<QPointF> _points; //!<全ポリゴンの頂点を連結した配列
+    QVector<int> _offsets; //!<各ポリゴンの先頭位置
+    QVector<double> _areaSize;
+};
+
+/*!
+ * \brief 点と線分との距離計算（getDistance）
+ */
+class DistanceBenchmark : public Benchmark
+{
+public:
+    QString name() const;
+    void setUp();
+    void run(int iterations);
+private:
+    QVector<QLineF> _lines;
+    QVector<QPointF> _points;
+};
+
+/*!
+ * \brief 点とポリゴンの全ての辺との距離計算（findNearestEdge）
+ */
+class NearestEdgeBenchmark : public Benchmark
+{
+public:
+    explicit NearestEdgeBenchmark(int vertexCount);
+    QString name() const;
+    QJsonObject parameters() const;
+    void setUp();
+    void run(int iterations);
+private:
+    int _vertexCount;
+    QVector<QPolygonF> _polygons;
+    QVector<QPointF> _points;
+};
+
+/*!
+ * \brief 相対座標と絶対座標の相互変換（calcRelativePosition/calcAbsolutePosition）
+ */
+class PositionConversionBenchmark : public Benchmark
+{
+public:
+    explicit PositionConversionBenchmark(int vertexCount);
+    QString name() const;
+    QJsonObject parameters() const;
+    void setUp();
+    void run(int iterations);
+private:
+    int _vertexCount;
+    QVector<QPolygonF> _polygons;
+};
+
+/*!
+ * \brief 選択モードでのクリック位置の当たり判定（MainWindow::selectItem相当）
+ * N個のポリゴンを総当たりで内外判定し、含まれるもののうち面積最小のものを選ぶ
+ */
+class SelectItemBenchmark : public Benchmark
+{
+public:
+    explicit SelectItemBenchmark(int polygonCount);
+    QString name() const;
+    QJsonObject parameters() const;
+    void setUp();
+    void run(int iterations);
+protected:
+    int _polygonCount;
+    QVector<QPolygonF> _polygons; //!< 画面上の（絶対座標の）ポリゴン
+    QVector<double> _areaSize; //!< 各ポリゴンの面積（_selectItemPolygonSizeList相当）
+    QVector<QPointF> _clickPoints; //!< クリック位置
+};
+
+/*!
+ * \brief 空間インデックスを使用した当たり判定（PolygonGridIndex::smallestContaining）
+ * SelectItemBenchmarkと同じポリゴン・クリック位置で計測する
+ */
+class SelectItemIndexBenchmark : public SelectItemBenchmark
+{
+public:
+    explicit SelectItemIndexBenchmark(int polygonCount);
+    QString name() const;
+    void setUp();
+    void run(int iterations);
+private:
+    PolygonGridIndex _index;
+};
+
+#endif // BENCHMARKCASES_H
@@ -0,0 +1,23 @@
+#-------------------------------------------------
+#
+# メタデータ入出力・座標計算・当たり判定のベンチマーク
+#
+#-------------------------------------------------
+
+QT       = core gui
+
+TARGET = ComicMetaBenchmark
+TEMPLATE = app
+CONFIG += console c++11
+CONFIG -= app_bundle
+
+include(../ComicMetaEditorCore/ComicMetaEditorCore.pri)
+
+SOURCES +=\
+    Main.cpp \
+    Benchmark.cpp \
+    BenchmarkCases.cpp
+
+HEADERS  += \
+    Benchmark.h \
+    BenchmarkCases.h
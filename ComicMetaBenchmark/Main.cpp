@@ -0,0 +1,89 @@
+﻿/*!
+ * \file
+ * \brief メタデータ入出力・座標計算・当たり判定のベンチマーク 実行用
+ * \date 2026/10/17 新規作成
+ *
+ * 使い方: ComicMetaBenchmark [-o 出力ファイル] [--min-time ミリ秒] [--repeat 回数] [--filter 名前]\n
+ * 結果はJSON形式で出力する（出力ファイル未指定時は標準出力）。進捗は標準エラー出力に表示する
+ */
+#include "BenchmarkCases.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QSysInfo>
+#include <iostream>
+
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("ComicMetaBenchmark");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Benchmarks metadata I/O, geometry functions and hit-testing.");
+    parser.addHelpOption();
+    QCommandLineOption outputOption(QStringList() << "o" << "output",
+                                    "Write the JSON results to <file> instead of stdout.", "file");
+    QCommandLineOption minTimeOption("min-time",
+                                     "Minimum duration of one measurement in ms (default: 200).", "ms");
+    QCommandLineOption repeatOption("repeat",
+                                    "Number of measurements; the fastest is reported (default: 3).", "n");
+    QCommandLineOption filterOption("filter",
+                                    "Run only benchmarks whose name contains <name>.", "name");
+    parser.addOption(outputOption);
+    parser.addOption(minTimeOption);
+    parser.addOption(repeatOption);
+    parser.addOption(filterOption);
+    parser.process(app);
+
+    BenchmarkRunner runner;
+    if(parser.isSet(minTimeOption)) runner.setMinimumTime(parser.value(minTimeOption).toInt());
+    if(parser.isSet(repeatOption)) runner.setRepeatCount(parser.value(repeatOption).toInt());
+    runner.setFilter(parser.value(filterOption));
+
+    //!ページメタデータの入出力（注釈数10, 100, 1000）
+    const int annotationCounts[] = {10, 100, 1000};
+    for(int i=0; i<3; i++){
+        runner.add(new WritePageBenchmark(annotationCounts[i]));
+        runner.add(new LoadPageBenchmark(annotationCounts[i]));
+    }
+
+    //!座標計算
+    const int vertexCounts[] = {4, 16};
+    for(int i=0; i<2; i++){
+        runner.add(new PolygonAreaBenchmark(vertexCounts[i]));
+        runner.add(new PolygonAreaBatchBenchmark(vertexCounts[i]));
+        runner.add(new NearestEdgeBenchmark(vertexCounts[i]));
+        runner.add(new PositionConversionBenchmark(vertexCounts[i]));
+    }
+    runner.add(new DistanceBenchmark);
+
+    //!選択モードの当たり判定（ポリゴン数10, 100, 1000）
+    for(int i=0; i<3; i++){
+        runner.add(new SelectItemBenchmark(annotationCounts[i]));
+        runner.add(new SelectItemIndexBenchmark(annotationCounts[i]));
+    }
+
+    QJsonObject root;
+    root.insert("application", QCoreApplication::applicationName());
+    root.insert("qt_version", QString(qVersion()));
+    root.insert("cpu", QSysInfo::currentCpuArchitecture());
+    root.insert("os", QSysInfo::prettyProductName());
+    root.insert("timestamp", QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+    root.insert("results", runner.runAll());
+    QByteArray json = QJsonDocument(root).toJson(QJsonDocument::Indented);
+
+    if(!parser.isSet(outputOption)){
+        cout << json.constData();
+        return 0;
+    }
+    QSaveFile file(parser.value(outputOption));
+    if(!file.open(QIODevice::WriteOnly) || file.write(json) != json.size() || !file.commit()){
+        cerr << "Cannot write " << parser.value(outputOption).toStdString() << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,21 @@
+#-------------------------------------------------
+#
+# 負荷試験用の合成コーパス（ページ画像とメタデータ）生成ツール
+#
+#-------------------------------------------------
+
+QT       = core gui concurrent
+
+TARGET = ComicMetaCorpusGenerator
+TEMPLATE = app
+CONFIG += console c++11
+CONFIG -= app_bundle
+
+include(../ComicMetaEditorCore/ComicMetaEditorCore.pri)
+
+SOURCES +=\
+    Main.cpp \
+    CorpusGenerator.cpp
+
+HEADERS  += \
+    CorpusGenerator.h
@@ -0,0 +1,154 @@
+﻿/*! \file
+ *  \brief 合成コーパスの生成処理 実装部
+ *  \date 2026/10/17 新規作成
+ */
+
+#include "CorpusGenerator.h"
+#include "GraphicsItemData.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QImageWriter>
+#include <QPainter>
+#include <random>
+
+/*!
+ * \brief ページ毎の乱数シードを求める
+ */
+static quint32 pageSeed(quint32 seed, int episodeNumber, int pageNumber)
+{
+    std::seed_seq sequence{seed, quint32(episodeNumber), quint32(pageNumber)};
+    quint32 value = 0;
+    sequence.generate(&value, &value + 1);
+    return value;
+}
+
+/*!
+ * \brief 相対座標のポリゴン群を画像に描画する
+ */
+template <typename T>
+static void drawPolygons(QPainter &painter, const QVector<T> &list, int width, int height)
+{
+    for(int i=0; i<list.size(); i++){
+        painter.drawPolygon(calcAbsolutePosition(list.at(i).GIData._relativePosition, width, height));
+    }
+}
+
+CorpusSpec::CorpusSpec()
+{
+    workTitle = "Synthetic";
+    castCount = 20;
+    episodeCount = 1;
+    pageCount = 20;
+    seed = 1;
+    imageFormat = "jpg";
+    imageQuality = -1;
+}
+
+QString CorpusSpec::episodeDirectory(int episodeNumber) const
+{
+    return QString("%1/episode%2").arg(outputDirectory).arg(episodeNumber, 4, 10, QChar('0'));
+}
+
+QString CorpusSpec::metadataDirectory(int episodeNumber) const
+{
+    //!エディタと同じく、画像のディレクトリ直下のmetadataディレクトリに置く
+    return QString("%1/metadata").arg(episodeDirectory(episodeNumber));
+}
+
+bool writeCorpusCommon(const CorpusSpec &spec, int episodeNumber, QString *error)
+{
+    QString directory = spec.metadataDirectory(episodeNumber);
+    if(!QDir().mkpath(directory)){
+        if(error) *error = QString("cannot create %1").arg(directory);
+        return false;
+    }
+    ComicMetadata metadata;
+    createSyntheticCommon(metadata, spec.workTitle, spec.castCount);
+    QString fileName = QString("%1/ComicMetadata.xml").arg(directory);
+    QSaveFile file(fileName);
+    if(!file.open(QIODevice::WriteOnly) || !metadata.writeMetadata_Common(&file) || !file.commit()){
+        if(error) *error = QString("cannot write %1").arg(fileName);
+        return false;
+    }
+    return true;
+}
+
+CorpusPageGenerator::CorpusPageGenerator(const CorpusSpec *spec)
+{
+    _spec = spec;
+}
+
+CorpusPageResult CorpusPageGenerator::operator()(const CorpusPage &page) const
+{
+    CorpusPageResult result;
+    ComicMetadata metadata;
+    createSyntheticCommon(metadata, _spec->workTitle, _spec->castCount);
+    createSyntheticPage(metadata, _spec->page, page.episodeNumber, page.pageNumber,
+                        pageSeed(_spec->seed, page.episodeNumber, page.pageNumber));
+
+    QString baseName = QString("%1").arg(page.pageNumber, 4, 10, QChar('0'));
+    if(!_spec->imageFormat.isEmpty()){
+        metadata.imageFileName = QString("%1.%2").arg(baseName).arg(_spec->imageFormat);
+    }
+
+    //!ページ画像
+    if(!_spec->imageFormat.isEmpty()){
+        QString imageFileName = QString("%1/%2").arg(_spec->episodeDirectory(page.episodeNumber))
+                .arg(metadata.imageFileName);
+        QImageWriter writer(imageFileName, _spec->imageFormat.toLatin1());
+        if(_spec->imageQuality >= 0) writer.setQuality(_spec->imageQuality);
+        if(!writer.write(renderCorpusPageImage(metadata))){
+            result.error = QString("%1: %2").arg(imageFileName).arg(writer.errorString());
+            return result;
+        }
+        result.bytes += QFileInfo(imageFileName).size();
+    }
+
+    //!ページメタデータ（ファイル毎の出力ログを抑えるため、書き込み先を直接渡す）
+    QString xmlFileName = QString("%1/%2.xml").arg(_spec->metadataDirectory(page.episodeNumber)).arg(baseName);
+    QSaveFile file(xmlFileName);
+    if(!file.open(QIODevice::WriteOnly) || !metadata.writeMetadata_Page(&file)){
+        file.cancelWriting();
+        result.error = QString("cannot write %1").arg(xmlFileName);
+        return result;
+    }
+    qint64 xmlBytes = file.size();
+    if(!file.commit()){
+        result.error = QString("cannot write %1").arg(xmlFileName);
+        return result;
+    }
+    result.bytes += xmlBytes;
+    result.succeeded = true;
+    return result;
+}
+
+QImage renderCorpusPageImage(const ComicMetadata &metadata)
+{
+    int width = metadata.imageWidth;
+    int height = metadata.imageHeight;
+    QImage image(width, height, QImage::Format_RGB32);
+    image.fill(Qt::white);
+
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    //!登場人物・アイテムは塗りつぶし、セリフは吹き出し、オノマトペは輪郭のみ描く
+    painter.setPen(QPen(QColor(120, 120, 120), 2));
+    painter.setBrush(QColor(190, 190, 190));
+    drawPolygons(painter, *metadata.character.data(), width, height);
+    painter.setBrush(QColor(220, 220, 220));
+    drawPolygons(painter, *metadata.item.data(), width, height);
+    painter.setPen(QPen(Qt::black, 2));
+    painter.setBrush(Qt::white);
+    drawPolygons(painter, *metadata.dialog.data(), width, height);
+    painter.setPen(QPen(QColor(60, 60, 60), 4));
+    painter.setBrush(Qt::NoBrush);
+    drawPolygons(painter, *metadata.onomatopoeia.data(), width, height);
+
+    //!コマ枠は最後に描く
+    painter.setPen(QPen(Qt::black, 4));
+    drawPolygons(painter, *metadata.frame.data(), width, height);
+    painter.end();
+    return image;
+}
@@ -0,0 +1,83 @@
+﻿/*! \file
+ *  \brief 合成コーパスの生成処理
+ *  \date 2026/10/17 新規作成
+ */
+
+#ifndef CORPUSGENERATOR_H
+#define CORPUSGENERATOR_H
+
+#include "SyntheticMetadata.h"
+#include <QString>
+#include <QImage>
+
+/*!
+ * \brief 生成するコーパス全体の条件
+ */
+class CorpusSpec
+{
+public:
+    CorpusSpec();
+    QString outputDirectory; //!<出力先ディレクトリ
+    QString workTitle; //!<作品名
+    int castCount; //!<登場人物リストの人数
+    int episodeCount; //!<話数（1話につき1ディレクトリ）
+    int pageCount; //!<1話あたりのページ数
+    quint32 seed; //!<乱数シード
+    QString imageFormat; //!<ページ画像の形式（"jpg", "png"、空ならば画像を生成しない）
+    int imageQuality; //!<ページ画像の品質（0-100、-1で既定値）
+    SyntheticPageSpec page; //!<各ページの条件
+
+    QString episodeDirectory(int episodeNumber) const; //!<話のディレクトリ（ページ画像の置き場所）
+    QString metadataDirectory(int episodeNumber) const; //!<話のメタデータディレクトリ
+};
+
+/*!
+ * \brief 生成する1ページ分の情報
+ */
+struct CorpusPage
+{
+    int episodeNumber;
+    int pageNumber;
+};
+
+/*!
+ * \brief ページ毎の生成結果
+ */
+struct CorpusPageResult
+{
+    CorpusPageResult() : bytes(0), succeeded(false) {}
+    qint64 bytes; //!<書き込んだバイト数（画像とメタデータの合計）
+    bool succeeded;
+    QString error; //!<失敗した場合の内容
+};
+
+/*!
+ * \brief 話毎の共通メタデータ（ComicMetadata.xml）を出力する
+ * メタデータディレクトリが無い場合は作成する
+ * \return 出力の成否
+ */
+bool writeCorpusCommon(const CorpusSpec &spec, int episodeNumber, QString *error);
+
+/*!
+ * \brief QtConcurrent::mappedで使用するページ生成用の関数オブジェクト
+ * ページ毎のシードはコーパスのシード・話数・ページ番号から決めるため、
+ * 並列に生成しても生成順によらず同じ内容となる
+ */
+class CorpusPageGenerator
+{
+public:
+    typedef CorpusPageResult result_type;
+    explicit CorpusPageGenerator(const CorpusSpec *spec);
+    CorpusPageResult operator()(const CorpusPage &page) const;
+private:
+    const CorpusSpec *_spec;
+};
+
+/*!
+ * \brief メタデータの各注釈を描いたページ画像を生成する
+ * \param metadata ページメタデータ（相対座標）
+ * \return ページ画像
+ */
+QImage renderCorpusPageImage(const ComicMetadata &metadata);
+
+#endif // CORPUSGENERATOR_H
@@ -0,0 +1,196 @@
+﻿/*!
+ * \file
+ * \brief 負荷試験用の合成コーパス生成ツール 実行用
+ * \date 2026/10/17 新規作成
+ *
+ * 使い方: ComicMetaCorpusGenerator [オプション] 出力ディレクトリ\n
+ * 出力ディレクトリ以下に話毎のディレクトリ（episode0001等）を作成し、ページ画像と
+ * エディタと同じ形式のメタデータ（metadata/ComicMetadata.xml, metadata/0001.xml等）を生成する。
+ * 同じオプション・シードからは常に同じ内容が生成される
+ */
+#include "CorpusGenerator.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QThreadPool>
+#include <QtConcurrentMap>
+#include <iostream>
+
+using namespace std;
+
+/*!
+ * \brief "最小-最大"または"値"形式の範囲指定を読み取る
+ * \return 形式が正しくない場合false
+ */
+static bool parseRange(QString text, int &min, int &max)
+{
+    QStringList values = text.split('-');
+    bool okMin = false;
+    bool okMax = false;
+    if(values.size() == 1){
+        min = max = values.at(0).toInt(&okMin);
+        return okMin;
+    }
+    if(values.size() != 2) return false;
+    min = values.at(0).toInt(&okMin);
+    max = values.at(1).toInt(&okMax);
+    return okMin && okMax && min <= max;
+}
+
+/*!
+ * \brief 0以上の整数のオプション値を読み取る
+ * \return 形式が正しくない場合false
+ */
+static bool parseCount(const QCommandLineParser &parser, const QCommandLineOption &option, int &value)
+{
+    if(!parser.isSet(option)) return true;
+    bool ok = false;
+    int number = parser.value(option).toInt(&ok);
+    if(!ok || number < 0){
+        cerr << "Invalid value for --" << option.names().last().toStdString()
+             << ": " << parser.value(option).toStdString() << endl;
+        return false;
+    }
+    value = number;
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("ComicMetaCorpusGenerator");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Generates a synthetic corpus of page images and metadata for load testing.");
+    parser.addHelpOption();
+    QCommandLineOption seedOption("seed", "Random seed (default: 1).", "n");
+    QCommandLineOption episodesOption("episodes", "Number of episode directories (default: 1).", "n");
+    QCommandLineOption pagesOption("pages", "Number of pages per episode (default: 20).", "n");
+    QCommandLineOption framesOption("frames", "Frames per page (default: 6).", "n");
+    QCommandLineOption charactersOption("characters", "Characters per page (default: 4).", "n");
+    QCommandLineOption dialogsOption("dialogs", "Dialogs per page (default: 8).", "n");
+    QCommandLineOption onomatopoeiaOption("onomatopoeia", "Onomatopoeia per page (default: 2).", "n");
+    QCommandLineOption itemsOption("items", "Items per page (default: 2).", "n");
+    QCommandLineOption verticesOption("vertices", "Polygon vertex count, as <n> or <min>-<max> (default: 4-8).", "range");
+    QCommandLineOption castOption("cast", "Number of names in the character list (default: 20).", "n");
+    QCommandLineOption titleOption("title", "Work title (default: Synthetic).", "title");
+    QCommandLineOption widthOption("width", "Page image width (default: 1500).", "px");
+    QCommandLineOption heightOption("height", "Page image height (default: 1060).", "px");
+    QCommandLineOption formatOption("image-format", "Page image format: jpg, png or none (default: jpg).", "format");
+    QCommandLineOption qualityOption("quality", "Page image quality 0-100.", "n");
+    QCommandLineOption jobsOption(QStringList() << "j" << "jobs",
+                                  "Number of worker threads (default: all cores).", "n");
+    parser.addOption(seedOption);
+    parser.addOption(episodesOption);
+    parser.addOption(pagesOption);
+    parser.addOption(framesOption);
+    parser.addOption(charactersOption);
+    parser.addOption(dialogsOption);
+    parser.addOption(onomatopoeiaOption);
+    parser.addOption(itemsOption);
+    parser.addOption(verticesOption);
+    parser.addOption(castOption);
+    parser.addOption(titleOption);
+    parser.addOption(widthOption);
+    parser.addOption(heightOption);
+    parser.addOption(formatOption);
+    parser.addOption(qualityOption);
+    parser.addOption(jobsOption);
+    parser.addPositionalArgument("directory", "Output directory.", "<directory>");
+    parser.process(app);
+
+    if(parser.positionalArguments().size() != 1){
+        parser.showHelp(1);
+    }
+
+    //!生成条件を読み取る
+    CorpusSpec spec;
+    spec.outputDirectory = QDir(parser.positionalArguments().at(0)).absolutePath();
+    int seed = int(spec.seed);
+    bool ok = parseCount(parser, seedOption, seed)
+            && parseCount(parser, episodesOption, spec.episodeCount)
+            && parseCount(parser, pagesOption, spec.pageCount)
+            && parseCount(parser, framesOption, spec.page.frameCount)
+            && parseCount(parser, charactersOption, spec.page.characterCount)
+            && parseCount(parser, dialogsOption, spec.page.dialogCount)
+            && parseCount(parser, onomatopoeiaOption, spec.page.onomatopoeiaCount)
+            && parseCount(parser, itemsOption, spec.page.itemCount)
+            && parseCount(parser, castOption, spec.castCount)
+            && parseCount(parser, widthOption, spec.page.imageWidth)
+            && parseCount(parser, heightOption, spec.page.imageHeight)
+            && parseCount(parser, qualityOption, spec.imageQuality);
+    if(!ok) return 1;
+    spec.seed = quint32(seed);
+    if(parser.isSet(titleOption)) spec.workTitle = parser.value(titleOption);
+    if(parser.isSet(verticesOption)){
+        if(!parseRange(parser.value(verticesOption), spec.page.minVertexCount, spec.page.maxVertexCount)
+                || spec.page.minVertexCount < 3){
+            cerr << "Invalid value for --vertices: " << parser.value(verticesOption).toStdString() << endl;
+            return 1;
+        }
+    }
+    if(parser.isSet(formatOption)){
+        QString format = parser.value(formatOption).toLower();
+        if(format == "none") format.clear();
+        else if(format != "jpg" && format != "png"){
+            cerr << "Invalid value for --image-format: " << format.toStdString() << endl;
+            return 1;
+        }
+        spec.imageFormat = format;
+    }
+    if(spec.page.imageWidth <= 0 || spec.page.imageHeight <= 0){
+        cerr << "Invalid page size" << endl;
+        return 1;
+    }
+    if(parser.isSet(jobsOption)){
+        int jobs = parser.value(jobsOption).toInt();
+        if(jobs > 0) QThreadPool::globalInstance()->setMaxThreadCount(jobs);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    //!話毎のディレクトリと共通メタデータを作成する
+    QVector<CorpusPage> pages;
+    for(int episode=1; episode<=spec.episodeCount; episode++){
+        QString error;
+        if(!writeCorpusCommon(spec, episode, &error)){
+            cerr << error.toStdString() << endl;
+            return 1;
+        }
+        for(int page=1; page<=spec.pageCount; page++){
+            CorpusPage target;
+            target.episodeNumber = episode;
+            target.pageNumber = page;
+            pages.push_back(target);
+        }
+    }
+
+    //!ページ画像とページメタデータを並列に生成する
+    QVector<CorpusPageResult> results =
+            QtConcurrent::blockingMapped<QVector<CorpusPageResult> >(pages, CorpusPageGenerator(&spec));
+
+    qint64 bytes = 0;
+    int failed = 0;
+    for(int i=0; i<results.size(); i++){
+        if(!results.at(i).succeeded){
+            cerr << results.at(i).error.toStdString() << endl;
+            failed++;
+        }
+        bytes += results.at(i).bytes;
+    }
+    double seconds = timer.elapsed() / 1000.0;
+    cout << "Generated " << (pages.size() - failed) << " pages in " << spec.episodeCount << " episodes ("
+         << spec.page.annotationCount() << " annotations/page, "
+         << bytes / (1024.0 * 1024.0) << " MB) in " << seconds << " s";
+    if(seconds > 0){
+        cout << ", " << (pages.size() - failed) / seconds << " pages/s";
+    }
+    cout << endl;
+    if(failed > 0){
+        cout << failed << " pages failed" << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,24 @@
+#-------------------------------------------------
+#
+# ComicMetaEditor 全体のビルド用
+# ComicMetaEditorCore : GUIに依存しないメタデータ処理のライブラリ
+# ComicMetaEditor     : メタデータ編集用GUI
+# ComicMetaValidator  : メタデータの一括検証用コマンドラインツール
+# ComicMetaBenchmark  : メタデータ入出力・座標計算・当たり判定のベンチマーク
+# ComicMetaCorpusGenerator : 負荷試験用の合成コーパス生成ツール
+#
+#-------------------------------------------------
+
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    ComicMetaEditorCore \
+    ComicMetaEditor \
+    ComicMetaValidator \
+    ComicMetaBenchmark \
+    ComicMetaCorpusGenerator
+
+ComicMetaEditor.depends = ComicMetaEditorCore
+ComicMetaValidator.depends = ComicMetaEditorCore
+ComicMetaBenchmark.depends = ComicMetaEditorCore
+ComicMetaCorpusGenerator.depends = ComicMetaEditorCore
@@ -4,33 +4,39 @@
 #
 #-------------------------------------------------
 
-QT       += core gui xml
+QT       += core gui
 
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets concurrent
 
 TARGET = ComicMetaEditor
 TEMPLATE = app
 
+include(../ComicMetaEditorCore/ComicMetaEditorCore.pri)
 
 SOURCES +=\
-    FileUtility.cpp \
     FunctionalGraphicsView.cpp \
     Main.cpp \
     MainWindow.cpp \
     ComicMetaEditorSetting.cpp \
-    CommonFunction.cpp \
-    GraphicsItemData.cpp \
-    ComicMetadata.cpp
+    GraphicsPolygonItem.cpp \
+    PageImage.cpp \
+    PagePrefetcher.cpp \
+    PageCache.cpp \
+    TiledImageItem.cpp \
+    ThumbnailCache.cpp \
+    FilmstripWidget.cpp
 
 HEADERS  += \
-    Common.h \
-    FileUtility.h\
     FunctionalGraphicsView.h \
     MainWindow.h \
     ComicMetaEditorSetting.h \
-    CommonFunction.h \
-    GraphicsItemData.h \
-    ComicMetadata.h
+    GraphicsPolygonItem.h \
+    PageImage.h \
+    PagePrefetcher.h \
+    PageCache.h \
+    TiledImageItem.h \
+    ThumbnailCache.h \
+    FilmstripWidget.h
 
 
 FORMS    += \
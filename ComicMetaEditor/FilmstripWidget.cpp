@@ -0,0 +1,141 @@
+﻿/*! \file
+ *  \brief ディレクトリ内のページをサムネイルで一覧表示するフィルムストリップ 実装部
+ *  \date 2026/10/17 新規作成
+ */
+
+#include "FilmstripWidget.h"
+#include <QFileInfo>
+#include <QRunnable>
+#include <QScrollBar>
+
+/*!
+ * \brief サムネイルを1つ生成し、結果をウィジェットへキュー接続で通知するタスク
+ */
+class ThumbnailTask : public QRunnable
+{
+public:
+    ThumbnailTask(FilmstripWidget *widget, const ThumbnailCache *cache,
+                  int generation, int index, QString fileName) :
+        _widget(widget), _cache(cache), _generation(generation), _index(index), _fileName(fileName) {}
+    void run()
+    {
+        QImage image = _cache->thumbnail(_fileName);
+        QMetaObject::invokeMethod(_widget, "Sl_thumbnailReady", Qt::QueuedConnection,
+                                  Q_ARG(int, _generation), Q_ARG(int, _index), Q_ARG(QImage, image));
+    }
+private:
+    FilmstripWidget *_widget;
+    const ThumbnailCache *_cache;
+    int _generation;
+    int _index;
+    QString _fileName;
+};
+
+/*!
+ * \brief ディスクキャッシュの容量・期限を超えた分を削除するタスク
+ */
+class ThumbnailTrimTask : public QRunnable
+{
+public:
+    explicit ThumbnailTrimTask(const ThumbnailCache *cache) : _cache(cache) {}
+    void run() { _cache->trim(); }
+private:
+    const ThumbnailCache *_cache;
+};
+
+FilmstripWidget::FilmstripWidget(QWidget *parent) :
+    QListWidget(parent)
+{
+    int length = _thumbnailCache.thumbnailLength();
+    setViewMode(QListView::IconMode);
+    setFlow(QListView::LeftToRight);
+    setWrapping(false);
+    setMovement(QListView::Static);
+    setResizeMode(QListView::Adjust);
+    setUniformItemSizes(true);
+    setIconSize(QSize(length, length));
+    setGridSize(QSize(length + 16, length + 32));
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
+    setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    setMinimumHeight(length + 56);
+
+    //!表示中ページの読み込み（グローバルのスレッドプール）と競合しないよう1スレッドに制限する
+    _pool.setMaxThreadCount(1);
+    _generation = 0;
+    _pool.start(new ThumbnailTrimTask(&_thumbnailCache));
+
+    connect(horizontalScrollBar(), SIGNAL(valueChanged(int)),
+            this, SLOT(Sl_requestVisibleThumbnails()));
+    connect(this, SIGNAL(itemClicked(QListWidgetItem*)),
+            this, SLOT(Sl_itemClicked(QListWidgetItem*)));
+}
+
+FilmstripWidget::~FilmstripWidget()
+{
+    _pool.clear();
+    _pool.waitForDone();
+}
+
+void FilmstripWidget::setFileList(QStringList fileNames)
+{
+    if(fileNames == _fileNames) return;
+
+    //!未着手のサムネイル生成を破棄してから一覧を作り直す（実行中のものは世代で判別して捨てる）
+    _pool.clear();
+    _generation++;
+    clear();
+    _fileNames = fileNames;
+    _isRequested.fill(false, _fileNames.size());
+    for(int i=0; i<_fileNames.size(); i++){
+        QListWidgetItem *item = new QListWidgetItem(QFileInfo(_fileNames.at(i)).fileName());
+        item->setToolTip(_fileNames.at(i));
+        item->setTextAlignment(Qt::AlignHCenter);
+        addItem(item);
+    }
+    Sl_requestVisibleThumbnails();
+}
+
+void FilmstripWidget::setCurrentNumber(int number)
+{
+    if(number < 0 || number >= count()) return;
+    setCurrentRow(number);
+    scrollToItem(item(number), QAbstractItemView::PositionAtCenter);
+    Sl_requestVisibleThumbnails();
+}
+
+void FilmstripWidget::resizeEvent(QResizeEvent *event)
+{
+    QListWidget::resizeEvent(event);
+    Sl_requestVisibleThumbnails();
+}
+
+void FilmstripWidget::Sl_requestVisibleThumbnails()
+{
+    if(count() == 0) return;
+
+    //!画面内のものを優先し、前後1画面分も先に要求しておく
+    QRect visible = viewport()->rect();
+    QRect nearby = visible.adjusted(-visible.width(), 0, visible.width(), 0);
+    for(int i=0; i<count(); i++){
+        if(_isRequested.testBit(i)) continue;
+        QRect rect = visualItemRect(item(i));
+        if(!rect.intersects(nearby)) continue;
+        int priority = rect.intersects(visible) ? 1 : 0;
+        _isRequested.setBit(i);
+        _pool.start(new ThumbnailTask(this, &_thumbnailCache, _generation, i, _fileNames.at(i)), priority);
+    }
+}
+
+void FilmstripWidget::Sl_thumbnailReady(int generation, int index, QImage image)
+{
+    if(generation != _generation) return;
+    if(index < 0 || index >= count()) return;
+    if(image.isNull()) return;
+    item(index)->setIcon(QIcon(QPixmap::fromImage(image)));
+}
+
+void FilmstripWidget::Sl_itemClicked(QListWidgetItem *item)
+{
+    if(item == NULL) return;
+    emit signal_pageSelected(row(item));
+}
@@ -0,0 +1,59 @@
+﻿/*! \file
+ *  \brief ディレクトリ内のページをサムネイルで一覧表示するフィルムストリップ
+ *  \date 2026/10/17 新規作成
+ */
+
+#ifndef FILMSTRIPWIDGET_H
+#define FILMSTRIPWIDGET_H
+
+#include "ThumbnailCache.h"
+#include <QListWidget>
+#include <QStringList>
+#include <QThreadPool>
+#include <QBitArray>
+#include <QImage>
+
+/*!
+ * \brief 現在のディレクトリ内のページをサムネイルで横一列に表示するウィジェット
+ * サムネイルは専用のスレッドプール（1スレッド）で生成（またはディスクキャッシュから読み込み）し、
+ * 準備できたものから順に表示する。表示中のページの読み込みを妨げないよう、
+ * 要求するのは画面内とその前後のサムネイルのみとし、画面内のものを優先する。\n
+ * サムネイルがクリックされた場合、そのページの番号をsignal_pageSelectedで通知する
+ */
+class FilmstripWidget : public QListWidget
+{
+    Q_OBJECT
+public:
+    explicit FilmstripWidget(QWidget *parent = 0);
+    ~FilmstripWidget();
+
+    /*!
+     * \brief 表示するファイル一覧をセットする
+     * 現在の一覧と同じであれば何もしない
+     * \param fileNames ファイル名一覧（FileUtilityの並び順）
+     */
+    void setFileList(QStringList fileNames);
+
+    //! 現在のページを選択状態にする
+    void setCurrentNumber(int number);
+
+signals:
+    void signal_pageSelected(int number);
+
+private slots:
+    void Sl_thumbnailReady(int generation, int index, QImage image);
+    void Sl_itemClicked(QListWidgetItem *item);
+    void Sl_requestVisibleThumbnails(); //!< 画面内とその前後のサムネイルの生成を要求する
+
+protected:
+    void resizeEvent(QResizeEvent *event);
+
+private:
+    ThumbnailCache _thumbnailCache; //!< サムネイルのディスクキャッシュ
+    QStringList _fileNames; //!< 表示中のファイル一覧
+    QThreadPool _pool; //!< サムネイル生成専用のスレッドプール
+    QBitArray _isRequested; //!< サムネイルの生成を要求済みかどうか
+    int _generation; //!< ファイル一覧の世代（古い一覧に対する結果を破棄するため）
+};
+
+#endif // FILMSTRIPWIDGET_H
@@ -0,0 +1,41 @@
+﻿/*! \file
+ *  \brief 枠表示用のQGraphicsPolygonItem 実装部
+ *  \date 2026/10/17 新規作成
+ */
+
+#include "GraphicsPolygonItem.h"
+
+GraphicsPolygonItem::GraphicsPolygonItem(QGraphicsItem *parent) :
+    QGraphicsPolygonItem(parent)
+{
+}
+
+void GraphicsPolygonItem::setPolygon(const QPolygonF &polygon)
+{
+    QGraphicsPolygonItem::setPolygon(polygon);
+}
+
+QPolygonF GraphicsPolygonItem::polygon() const
+{
+    return QGraphicsPolygonItem::polygon();
+}
+
+void GraphicsPolygonItem::setBrush(const QBrush &brush)
+{
+    QGraphicsPolygonItem::setBrush(brush);
+}
+
+void GraphicsPolygonItem::setPen(const QPen &pen)
+{
+    QGraphicsPolygonItem::setPen(pen);
+}
+
+GraphicsPolygonView *GraphicsPolygonItem::create()
+{
+    return new GraphicsPolygonItem();
+}
+
+QGraphicsPolygonItem *toGraphicsItem(GraphicsPolygonView *view)
+{
+    return static_cast<GraphicsPolygonItem*>(view);
+}
@@ -0,0 +1,38 @@
+﻿/*! \file
+ *  \brief 枠表示用のQGraphicsPolygonItem
+ *  \date 2026/10/17 新規作成
+ */
+
+#ifndef GRAPHICSPOLYGONITEM_H
+#define GRAPHICSPOLYGONITEM_H
+
+#include "GraphicsItemData.h"
+#include <QGraphicsPolygonItem>
+
+/*!
+ * \brief GraphicsPolygonViewのQtWidgetsによる実装
+ * Main.cppにてcreate()をsetGraphicsPolygonViewFactoryに登録し、
+ * GraphicsItemDataの表示用アイテムとして使用する
+ */
+class GraphicsPolygonItem : public QGraphicsPolygonItem, public GraphicsPolygonView
+{
+public:
+    explicit GraphicsPolygonItem(QGraphicsItem *parent = 0);
+
+    void setPolygon(const QPolygonF &polygon);
+    QPolygonF polygon() const;
+    void setBrush(const QBrush &brush);
+    void setPen(const QPen &pen);
+
+    //! GraphicsItemDataの表示用アイテムの生成関数
+    static GraphicsPolygonView *create();
+};
+
+/*!
+ * \brief 表示用アイテムをシーンに追加できる形で取得する
+ * \param view GraphicsItemDataの表示用アイテム
+ * \return シーンに追加するアイテム（表示用アイテムが無い場合はNULL）
+ */
+QGraphicsPolygonItem *toGraphicsItem(GraphicsPolygonView *view);
+
+#endif // GRAPHICSPOLYGONITEM_H
@@ -3,12 +3,15 @@
  * \brief 全体実行用
  */
 #include "MainWindow.h"
+#include "GraphicsPolygonItem.h"
 #include <QApplication>
 
 
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
+    //!メタデータの枠はQGraphicsPolygonItemとしてシーンに表示する
+    setGraphicsPolygonViewFactory(GraphicsPolygonItem::create);
     MainWindow w;
     w.show();
 
@@ -7,6 +7,21 @@
 
 #include "MainWindow.h"
 #include "ui_MainWindow.h"
+#include "PagePrefetcher.h"
+#include "PageCache.h"
+#include "TiledImageItem.h"
+#include "FilmstripWidget.h"
+#include "MetadataSaveQueue.h"
+#include "GraphicsPolygonItem.h"
+#include "StageTrace.h"
+#include <QDockWidget>
+#include <QFileDialog>
+#include <QSaveFile>
+#include <QBuffer>
+#include <QFutureWatcher>
+#include <QThreadPool>
+#include <QPointer>
+#include <QtConcurrentRun>
 #ifdef Q_OS_MAC
 #include <math.h>
 #else
@@ -22,13 +37,25 @@ using namespace std;
 class MainWindowPrivateData{
 public:
     //ComicMetaEditorSetting _setting;
-    QImage _originalImage; //!< 読み込んだデータ
+    QSize _originalImageSize; //!< 読み込んだ画像の元サイズ
     int _targetImageLength; //!< 画像解像度の縮小が行われる場合（大きい画像用）の縮小ターゲットサイズ
     QSharedPointer<QImage> _image; //!< 実際に表示する画像の本体
     QSharedPointer<QGraphicsScene> _scene;//!< 表示用Graphics Scene
+    PagePrefetcher _prefetcher; //!< 前後ページの先読み用
+    PageCache _pageCache; //!< 一度表示したページ画像のキャッシュ
+    QThreadPool _refinePool; //!< 仮画像表示中の本読み込み専用のスレッドプール
+    QFutureWatcher<PageImage> _fullImageWatcher; //!< 仮画像表示中の本読み込み処理の監視用
+    QString _refiningFileName; //!< 本読み込み中の画像ファイル名
+    QPointer<TiledImageItem> _imageItem; //!< 表示中の画像アイテム（シーン消去時に自動的にNULLとなる）
+    MetadataSaveQueue _saveQueue; //!< メタデータのバックグラウンド保存用
+    //共通メタデータはディレクトリ内の全ページで共通のため、ファイルが更新されない限り読み直さない
+    QString _commonCacheFileName; //!< キャッシュしている共通メタデータのファイル名（無効時は空）
+    QDateTime _commonCacheStamp; //!< キャッシュした時点での共通メタデータファイルの更新日時
+    QString _commonCacheTitle; //!< キャッシュしている作品名
+    QVector<QString> _commonCacheCharacterName; //!< キャッシュしている登場人物リスト
     MainWindowPrivateData();
     ~MainWindowPrivateData();
-    double calcOriginalImageSizeRatio();
+    int displayImageLength();
 };
 
 /*!
@@ -40,6 +67,9 @@ public:
 MainWindowPrivateData::MainWindowPrivateData()
 {
     _targetImageLength = TARGET_IMAGE_LENGTH;
+    _prefetcher.setTargetImageLength(displayImageLength());
+    //!表示中ページの本読み込みがタイルやサムネイルの読み込みで待たされないよう専用に確保する
+    _refinePool.setMaxThreadCount(1);
 }
 
 /*!
@@ -51,27 +81,16 @@ MainWindowPrivateData::~MainWindowPrivateData()
 }
 
 /*!
- * \brief 元画像との画像サイズ比を計算する
- * \return 元画像を1.0としたときの、表示に使用するターゲット画像のサイズ比
+ * \brief 表示用画像の縮小ターゲットサイズを返す
+ * \return 縮小ターゲットサイズ（サイズ変換を行わない場合は0）
  */
-double MainWindowPrivateData::calcOriginalImageSizeRatio()
+int MainWindowPrivateData::displayImageLength()
 {
-    double originalImageSizeRatio = 1.0;
     bool sizeConversion = IMAGE_SIZE_CONVERSION;
     if(sizeConversion){
-        if(_image.data()->isNull() || _originalImage.isNull()){
-            originalImageSizeRatio = 0.0;
-        }
-        else{
-            double dx = (double)_targetImageLength / _image.data()->width();
-            double dy = (double)_targetImageLength / _image.data()->height();
-            originalImageSizeRatio = min(dx,dy);
-        }
-    }
-    else{
-        originalImageSizeRatio = 1.0;
+        return _targetImageLength;
     }
-    return originalImageSizeRatio;
+    return 0;
 }
 
 /*!
@@ -364,6 +383,37 @@ MainWindow::MainWindow(QWidget *parent) :
     connectGraphicsView();
     connect(this, SIGNAL(signal_setStatusBarMessage(QString, int)),
             ui->statusBar, SLOT(showMessage(QString, int)));
+    connect(&_pdata.data()->_fullImageWatcher, SIGNAL(finished()),
+            this, SLOT(Sl_fullImageLoaded()));
+    connect(&_pdata.data()->_saveQueue, SIGNAL(signal_saveFailed(QString)),
+            this, SLOT(Sl_metadataSaveFailed(QString)));
+
+    //!ページ一覧（フィルムストリップ）を画面下部に配置する
+    _filmstrip = new FilmstripWidget(this);
+    QDockWidget *filmstripDock = new QDockWidget(tr("Filmstrip"), this);
+    filmstripDock->setObjectName("FilmstripDock");
+    filmstripDock->setWidget(_filmstrip);
+    addDockWidget(Qt::BottomDockWidgetArea, filmstripDock);
+    ui->menuView->addSeparator();
+    ui->menuView->addAction(filmstripDock->toggleViewAction());
+    connect(_filmstrip, SIGNAL(signal_pageSelected(int)),
+            this, SLOT(Sl_filmstripPageSelected(int)));
+    connect(&_fileUtility, SIGNAL(signal_fileListChanged()),
+            this, SLOT(Sl_fileListChanged()));
+
+    //!処理段階毎の所要時間の計測（トレース）用メニュー
+    //環境変数COMICMETAEDITOR_TRACEが設定されていれば起動時から計測し、値が1以外であれば終了時にそのファイルへ出力する
+    QMenu *traceMenu = ui->menuBar->addMenu(tr("Trace"));
+    QAction *traceAction = traceMenu->addAction(tr("Enable Stage Tracing"));
+    traceAction->setCheckable(true);
+    connect(traceAction, SIGNAL(toggled(bool)), this, SLOT(Sl_traceToggled(bool)));
+    traceMenu->addAction(tr("Save Trace..."), this, SLOT(Sl_saveTrace()));
+    traceMenu->addAction(tr("Clear Trace"), this, SLOT(Sl_clearTrace()));
+    QByteArray traceEnv = qgetenv("COMICMETAEDITOR_TRACE");
+    if(!traceEnv.isEmpty() && traceEnv != "0"){
+        if(traceEnv != "1") _traceFileName = QString::fromLocal8Bit(traceEnv);
+        traceAction->setChecked(true);
+    }
     displayMousePosition(QPoint(0,0));
 
     //Info
@@ -374,14 +424,22 @@ MainWindow::MainWindow(QWidget *parent) :
 
     //!メタデータ格納用のディレクトリパスを設定する
     _metadataDirectoryName = "metadata";
-    _commonMetadataEdit = false;
-    _pageMetadataEdit = false;
     clearScene();
 }
 
 
 MainWindow::~MainWindow()
 {
+    //!未保存の編集内容を保存し、XMLファイルへの反映が終わるまで待つ
+    if(_metadata.isChanged()){
+        writeMetaData();
+    }
+    _pdata.data()->_saveQueue.checkpoint();
+    _pdata.data()->_saveQueue.flush();
+    disconnect(&_pdata.data()->_saveQueue, 0, this, 0);
+    if(!_traceFileName.isEmpty()){
+        writeTrace(_traceFileName);
+    }
     cancelAllMode();
     delete ui;
 #ifdef P_DESTRUCT
@@ -399,7 +457,8 @@ MainWindow::~MainWindow()
  */
 bool MainWindow::openImageFile(QString fileName, bool loadMetadataStatus)
 {
-    if(_commonMetadataEdit || _pageMetadataEdit){
+    STAGE_TRACE("openImageFile");
+    if(_metadata.isChanged()){
         writeMetaData();
     }
 
@@ -410,10 +469,51 @@ bool MainWindow::openImageFile(QString fileName, bool loadMetadataStatus)
     metaDataListClear();
     refresh_ALL_ListWidget();
 
-    //!画像ファイルを読み込む
+    //!画像ファイルを読み込む（キャッシュ済み・先読み済みであればその結果を使用する）
+    //画像サイズ変換が有効であった場合、一定サイズまで画像サイズを変更したものが返される
     QString msg = tr("open image file : ") + fileName + tr(" ... ");
-    if(_pdata.data()->_image.data()->load(fileName)){
-        msg += "success!";
+    int imageLength = _pdata.data()->displayImageLength();
+    PageImage page;
+    QFuture<PageImage> future;
+    bool refining = false; //!< 仮画像を表示し、本読み込みをバックグラウンドで行う場合true
+    if(!_pdata.data()->_pageCache.find(fileName, page)){
+        bool prefetched = _pdata.data()->_prefetcher.take(fileName, future);
+        if(prefetched && future.isFinished()){
+            page = future.result();
+        }
+        else{
+            //!読み込みが終わっていなければ仮画像を表示し、本読み込みはバックグラウンドで行う
+            page = loadPreviewImage(fileName, imageLength);
+            if(!page.isNull()){
+                if(!prefetched){
+                    future = QtConcurrent::run(&_pdata.data()->_refinePool,
+                                               loadPageImage, fileName, imageLength);
+                }
+                refining = true;
+            }
+            else if(prefetched){
+                STAGE_TRACE("waitPrefetch");
+                page = future.result();
+            }
+            else{
+                page = loadPageImage(fileName, imageLength);
+            }
+        }
+        if(page.isNull() && !_pdata.data()->_pageCache.isEmpty()){
+            //!ヘッダが読める画像で失敗した場合はメモリ不足とみなし、
+            //読み込みに必要な分だけキャッシュを古いものから解放して再度読み込む
+            qint64 requiredBytes = estimatePageImageBytes(fileName, imageLength);
+            if(requiredBytes > 0){
+                PageCache &cache = _pdata.data()->_pageCache;
+                cache.trim(cache.totalBytes() - requiredBytes);
+                page = loadPageImage(fileName, imageLength);
+            }
+        }
+        if(!refining && !page.isNull()) _pdata.data()->_pageCache.insert(page);
+    }
+    if(!page.isNull()){
+        msg += "success! [" + _pdata.data()->_pageCache.statistics()
+                + ", " + _pdata.data()->_prefetcher.statistics() + "]";
         setStatusBarMessage(msg);
         ui->label_FileName->setText(fileName);
     }
@@ -422,29 +522,35 @@ bool MainWindow::openImageFile(QString fileName, bool loadMetadataStatus)
         setStatusBarMessage(msg);
         return false;
     }
+    *_pdata.data()->_image.data() = page.image;
+    _pdata.data()->_originalImageSize = page.originalSize;
 
-    //!画像サイズ変換が有効であった場合、一定サイズまで画像サイズを変更する
-    //読み込んだ画像が大きすぎて表示に時間がかかる場合に対応したもの
-    bool status = IMAGE_SIZE_CONVERSION;
-    if(status){
-        _pdata.data()->_originalImage = *_pdata.data()->_image.data();
-        double sizeRatio = _pdata.data()->calcOriginalImageSizeRatio();
-        int convertedWidth = sizeRatio * _pdata.data()->_image.data()->width();
-        int convertedHeight = sizeRatio * _pdata.data()->_image.data()->height();
-        //cout << "image size convertion => convertedWidth:"
-            //<< convertedWidth << " convertedHeight:" << convertedHeight << endl;
-        *_pdata.data()->_image.data() = _pdata.data()->_originalImage.scaled
-                (convertedWidth, convertedHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    //!画像が読み込めたらファイルユーティリティーに名前をセットする
+    //ディレクトリの一覧に見つからない場合（拡張子フィルタの対象外等）は前後のページ移動がずれるため通知する
+    if(!_fileUtility.setFile(fileName)){
+        setStatusBarMessage(tr("file not found in directory list : ") + fileName, 0);
     }
-    else{
+
+    //!前後のページのうちキャッシュにないものをワーカースレッドで先読みしておく
+    QStringList neighbours;
+    neighbours << _fileUtility.getNextFileName() << _fileUtility.getPreviousFileName();
+    for(int i=neighbours.size()-1; i>=0; i--){
+        if(_pdata.data()->_pageCache.contains(neighbours.at(i))) neighbours.removeAt(i);
     }
+    _pdata.data()->_prefetcher.prefetch(neighbours);
 
-    //!画像が読み込めたらファイルユーティリティーに名前をセットする
-    _fileUtility.setFile(fileName);
+    //!ページ一覧上で現在のページを選択状態にする
+    _filmstrip->setCurrentNumber(_fileUtility.getCurrentNumber());
 
     //!画像の表示
-    QPixmap pixmap = QPixmap::fromImage(*_pdata.data()->_image.data());
-    _pdata.data()->_scene.data()->addPixmap(pixmap);
+    //拡大表示時には元画像から必要な解像度のタイルが読み込まれる
+    TiledImageItem *imageItem = new TiledImageItem(page.fileName, page.image, page.originalSize);
+    _pdata.data()->_scene.data()->addItem(imageItem);
+    _pdata.data()->_imageItem = imageItem;
+    if(refining){
+        _pdata.data()->_refiningFileName = page.fileName;
+        _pdata.data()->_fullImageWatcher.setFuture(future);
+    }
     fitScale();
 
     //!メタデータを読み込む設定であれば読み込み処理を行う
@@ -454,12 +560,142 @@ bool MainWindow::openImageFile(QString fileName, bool loadMetadataStatus)
 
     _metadata.imageFileName = _fileUtility.getCurrentFileNameCore();
     //_metadata.imageFileName = _fileUtility.getCurrentFileNameCore_WOExt();//拡張子なし
-    _metadata.imageWidth = _pdata.data()->_originalImage.width();
-    _metadata.imageHeight = _pdata.data()->_originalImage.height();
+    _metadata.imageWidth = _pdata.data()->_originalImageSize.width();
+    _metadata.imageHeight = _pdata.data()->_originalImageSize.height();
+
+    //!読み込んだ直後の状態を未変更として記録する
+    //メタデータを読み込まない場合（メタデータの消去）は、ページメタデータを変更扱いとする
+    if(loadMetadataStatus){
+        _metadata.clearChanged();
+    }
+    else{
+        _metadata.markChanged(ComicMetadata_All);
+    }
 
     return true;
 }
 
+/*!
+ * \brief 仮画像表示中のページについて、本読み込みが完了した際の動作
+ * 表示用画像とサイズは同じであるため、シーン上のアイテムの座標はそのまま使用できる
+ */
+void MainWindow::Sl_fullImageLoaded()
+{
+    QFuture<PageImage> future = _pdata.data()->_fullImageWatcher.future();
+    if(future.resultCount() == 0) return;
+    PageImage page = future.result();
+    QString fileName = _pdata.data()->_refiningFileName;
+    bool isCurrent = (fileName == _fileUtility.getCurrentFileName());
+    if(page.isNull()){
+        //!表示中のページであれば同期的に読み直し、それでも失敗した場合は仮画像のままであることを通知する
+        if(!isCurrent) return;
+        page = loadPageImage(fileName, _pdata.data()->displayImageLength());
+        if(page.isNull()){
+            setStatusBarMessage(tr("failed to load full image (showing preview) : ") + fileName, 0);
+            return;
+        }
+    }
+    _pdata.data()->_pageCache.insert(page);
+
+    //!既に別のページに切り替わっている場合はキャッシュへの格納のみ行う
+    if(!isCurrent) return;
+    if(_pdata.data()->_imageItem.isNull()) return;
+    if(page.image.size() != _image.data()->size()){
+        STAGE_TRACE("QImage::scaled");
+        page.image = page.image.scaled(_image.data()->size(),
+                                       Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+    *_image.data() = page.image;
+    _pdata.data()->_imageItem.data()->setBaseImage(page.image);
+}
+
+/*!
+ * \brief ディレクトリ内のファイル一覧が読み直された際の動作
+ * ページ一覧（フィルムストリップ）を更新する
+ */
+void MainWindow::Sl_fileListChanged()
+{
+    QStringList fileNames;
+    for(int i=0; i<_fileUtility.size(); i++){
+        fileNames.push_back(_fileUtility.getFileName(i));
+    }
+    _filmstrip->setFileList(fileNames);
+    _filmstrip->setCurrentNumber(_fileUtility.getCurrentNumber());
+}
+
+/*!
+ * \brief メタデータのバックグラウンド保存に失敗した際の動作
+ * \param fileName 書き込めなかったメタデータファイル名
+ */
+void MainWindow::Sl_metadataSaveFailed(QString fileName)
+{
+    setStatusBarMessage(tr("failed to save metadata : ") + fileName, 0);
+}
+
+/*!
+ * \brief トレースの有効・無効が切り替えられた際の動作
+ * \param enabled 有効にする場合true
+ */
+void MainWindow::Sl_traceToggled(bool enabled)
+{
+    StageTrace::setEnabled(enabled);
+    setStatusBarMessage(enabled ? tr("stage tracing enabled") : tr("stage tracing disabled"));
+}
+
+/*!
+ * \brief 記録したトレースを、保存先を選択して出力する
+ */
+void MainWindow::Sl_saveTrace()
+{
+    QString fileName = QFileDialog::getSaveFileName
+        (this, tr("Save Trace"), "trace.json", tr("Chrome Trace (*.json)"));
+    if(fileName.isEmpty()) return;
+    if(writeTrace(fileName)){
+        setStatusBarMessage(tr("trace saved : ") + fileName);
+    }
+    else{
+        setStatusBarMessage(tr("failed to save trace : ") + fileName, 0);
+    }
+}
+
+/*!
+ * \brief 記録したトレースを消去する
+ */
+void MainWindow::Sl_clearTrace()
+{
+    StageTrace::clear();
+    setStatusBarMessage(tr("trace cleared"));
+}
+
+/*!
+ * \brief トレースをChromeのトレースイベント形式で出力する
+ * ステージ毎の集計結果は、同じ場所に"_summary.txt"を付けたファイル名で出力する
+ * \param fileName 出力先ファイル名
+ * \return 出力の成否
+ */
+bool MainWindow::writeTrace(QString fileName)
+{
+    QByteArray summary = StageTrace::summary().toUtf8();
+    QFileInfo info(fileName);
+    QSaveFile summaryFile(QString("%1/%2_summary.txt").arg(info.absolutePath()).arg(info.completeBaseName()));
+    bool summarySaved = summaryFile.open(QIODevice::WriteOnly | QIODevice::Text)
+            && summaryFile.write(summary) == summary.size()
+            && summaryFile.commit();
+    bool traceSaved = StageTrace::writeChromeTrace(fileName);
+    return summarySaved && traceSaved;
+}
+
+/*!
+ * \brief フィルムストリップでページが選択された際の動作
+ * \param number ディレクトリ内のページ番号
+ */
+void MainWindow::Sl_filmstripPageSelected(int number)
+{
+    QString fileName = _fileUtility.getFileName(number);
+    if(fileName.isEmpty() || fileName == _fileUtility.getCurrentFileName()) return;
+    openImageFile(fileName);
+}
+
 /*!
  * \brief 画面下部のステータスバーにメッセージを表示するための関数
  * \param message メッセージ内容
@@ -488,14 +724,26 @@ void MainWindow::displayMousePosition(QPoint pt)
  */
 void MainWindow::clearScene()
 {
+    STAGE_TRACE("clearScene");
     //シーン本体のリセット
     _scene.data()->clear();
     //各種Itemのリセット
     _metadata.clear();
+    clearPolygonIndex();
     releaseSpecificItems();
     metaDataUIClear();
 }
 
+/*!
+ * \brief 当たり判定用の空間インデックスを全て消去する
+ */
+void MainWindow::clearPolygonIndex()
+{
+    for(int i=0; i<ComicMetadata_All; i++){
+        _polygonIndex[i].clear();
+    }
+}
+
 /*!
  * \brief 画像の表示倍率をウィンドウサイズに合わせて調整する
  */
@@ -836,13 +1084,12 @@ void MainWindow::setOrderModeStart(ComicMetadataType type)
         return;
     }
 
-    //! 順序変更用ターゲットに入っている各ポリゴンの面積を計算しておく
-    _isSetOrderModePolygonSizeList.clear();
+    //! 順序変更用ターゲットの当たり判定用インデックスと、選択済みフラグを準備する
+    _setOrderIndex.clear();
     for(int i=0; i<_setOrderTarget.size(); i++){
-        GraphicsItemData GIData = _setOrderTarget.at(i);
-        QPolygonF polygon = GIData.item()->polygon();
-        _isSetOrderModePolygonSizeList.push_back(calcPolygonAreaSize(polygon));
+        _setOrderIndex.append(_setOrderTarget.at(i));
     }
+    _isSetOrderModeSelected.fill(false, _setOrderTarget.size());
     //! 終了
 }
 
@@ -858,7 +1105,8 @@ void MainWindow::setOrderModeCancel()
     //! 順序入れ替え用データをクリアする
     _setOrderTarget.clear();
     _isSetOrderModeSelectedList.clear();
-    _isSetOrderModePolygonSizeList.clear();
+    _isSetOrderModeSelected.clear();
+    _setOrderIndex.clear();
 
     //! 順序情報表示用GraphicsItemを削除する
     for(int i=0; i<_orderNumberRect.size(); i++){
@@ -880,24 +1128,20 @@ void MainWindow::setOrderModeCancel()
  * \brief setOrderModeでの変更を確定して終了する
  * \brief MainWindow::setOrderModeTerminate
  * \note 現時点ではコマの情報のみ順序変更対応
- * 順序入れ替え結果を反映する際には\n
- * 各データを、新しい順番で一時ストック用データ置き場に保持し、一旦元データはクリア\n
- * その後ストックしておいたデータをコピーするという手順で行う
+ * 順序入れ替えはComicMetadata::reorderItemsで行い、各注釈の対象コマもそこで更新される
  */
 void MainWindow::setOrderModeTerminate()
 {
     //! 指定されているデータを、新しい順番に入れ替える
     switch(_setOrderTargetType){//現時点ではコマのみ対応
     case ComicMetadata_Frame:{
-        QVector<FrameData> newFrameData;//一時ストック用
-        for(int i=0; i<_isSetOrderModeSelectedList.size(); i++){
-            newFrameData.push_back(_metadata.frame.data()->at(_isSetOrderModeSelectedList.at(i)));
+        if(!_metadata.reorderItems(ComicMetadata_Frame, _isSetOrderModeSelectedList)) break;
+        _polygonIndex[ComicMetadata_Frame].clear();
+        for(int i=0; i < _metadata.frame.data()->size(); i++){
+            _polygonIndex[ComicMetadata_Frame].append(_metadata.frame.data()->at(i).GIData);
         }
-        _metadata.frame.data()->clear();
-        for(int i=0; i < newFrameData.size(); i++){
-            _metadata.frame.data()->push_back(newFrameData.at(i));
-        }
-        refresh_Frame_ListWidget();
+        //! 各注釈の対象コマの番号も変わるため全てのリストを更新する
+        refresh_ALL_ListWidget();
         break;
     }
     case ComicMetadata_Character:
@@ -932,26 +1176,21 @@ void MainWindow::setOrderModeMouseClick(QPoint pt)
         return;
     }
     //! もし未選択のアイテム上でクリックされた場合には、選択されたアイテムの番号をselectedListに追加し、番号を表示する
-    int selected = selectItem(_setOrderTarget, _isSetOrderModePolygonSizeList, pt, _isSetOrderModeSelectedList);
-    bool selectedStatus = false;
-    for(int i=0; i<_isSetOrderModeSelectedList.size(); i++){
-        if(selected == _isSetOrderModeSelectedList.at(i)){
-            selectedStatus = true;
-        }
-    }
+    int selected = selectItem(_setOrderIndex, pt);
     //! 既に選択されているアイテムの上であった場合か、何の上でもない場合には終了
-    if(selectedStatus || selected < 0){
+    if(selected < 0 || _isSetOrderModeSelected.testBit(selected)){
         return;
     }
 
-    //! 選択されていないアイテムの上であった場合、選択状態に移行する
+    //! 選択されていないアイテムの上であった場合、選択状態に移行する（以降の当たり判定の対象から外す）
     _isSetOrderModeSelectedList.push_back(selected);
+    _isSetOrderModeSelected.setBit(selected);
+    _setOrderIndex.setActive(selected, false);
     GraphicsItemData GIData = _setOrderTarget.at(selected);
     GIData.colorDefault();
     _selectedItemNumber = -1;
 
-    QPolygonF polygon = GIData._item->polygon();
-    QPointF center = getPolygonCenter(polygon);
+    QPointF center = GIData.center();
     center.setX(center.x() - 30);
     center.setY(center.y() - 30);
     int digit = (int)log10(_isSetOrderModeSelectedList.size()) + 1;
@@ -990,8 +1229,10 @@ void MainWindow::setOrderModeMouseRightClick()
     item = _setOrderTarget.at(previous);
     item.colorActive();
 
-    //! 設定済みであった最後のアイテム（一つ前に相当する）を除去する
+    //! 設定済みであった最後のアイテム（一つ前に相当する）を除去し、当たり判定の対象に戻す
     _isSetOrderModeSelectedList.removeLast();
+    _isSetOrderModeSelected.clearBit(previous);
+    _setOrderIndex.setActive(previous, true);
    if(!_orderNumberRect.isEmpty()){
         _scene.data()->removeItem(_orderNumberRect.at(_orderNumberRect.size()-1));
         _orderNumberRect.removeLast();
@@ -1013,15 +1254,13 @@ void MainWindow::setOrderModeMouseMove(QPoint pt)
     //! 処理開始
 
     //!　現在のマウス座標をもとに、選択されているアイテム番号を取得する
-    int selected = selectItem(_setOrderTarget, _isSetOrderModePolygonSizeList, pt, _isSetOrderModeSelectedList);
+    int selected = selectItem(_setOrderIndex, pt);
 
     //! 選択されている対象が、変更となる場合には以下を実行する
     if(selected != _selectedItemNumber){
         //! - 現在のマウス下がすでに選択されている番号であった場合には何もしない
-        for(int i=0; i<_isSetOrderModeSelectedList.size(); i++){
-            if(_isSetOrderModeSelectedList.at(i)== selected){
-                return;
-            }
+        if(selected >= 0 && _isSetOrderModeSelected.testBit(selected)){
+            return;
         }
 
         //! - 現在選択状態となっている物があり、かつ別の番号の上に移動した場合には、一旦現在選択状態の物を開放する
@@ -1173,9 +1412,10 @@ void MainWindow::terminateCreatePolygon()
         FrameData newframe;
         newframe.GIData.setPolygon(polygon, _image.data()->width(), _image.data()->height());
         newframe.GIData.colorDefault();
-        _scene.data()->addItem(newframe.GIData.item());
+        _scene.data()->addItem(toGraphicsItem(newframe.GIData.item()));
         _metadata.frame.data()->push_back(newframe);
-        _metadata.renewMangaPath_Frame(_metadata.frame.data()->size());
+        _polygonIndex[ComicMetadata_Frame].append(newframe.GIData);
+        _metadata.markChanged(ComicMetadata_Frame);
     }
         break;
     case ComicMetadata_Character:
@@ -1183,9 +1423,10 @@ void MainWindow::terminateCreatePolygon()
         CharacterData newcharacter;
         newcharacter.GIData.setPolygon(polygon, _image.data()->width(), _image.data()->height());
         newcharacter.GIData.colorDefault();
-        _scene.data()->addItem(newcharacter.GIData.item());
+        _scene.data()->addItem(toGraphicsItem(newcharacter.GIData.item()));
         _metadata.character.data()->push_back(newcharacter);
-        _metadata.renewMangaPath_Character(_metadata.character.data()->size()-1);
+        _polygonIndex[ComicMetadata_Character].append(newcharacter.GIData);
+        _metadata.markChanged(ComicMetadata_Character);
     }
         break;
     case ComicMetadata_Dialog:
@@ -1193,9 +1434,10 @@ void MainWindow::terminateCreatePolygon()
         DialogData newdialog;
         newdialog.GIData.setPolygon(polygon, _image.data()->width(), _image.data()->height());
         newdialog.GIData.colorDefault();
-        _scene.data()->addItem(newdialog.GIData.item());
+        _scene.data()->addItem(toGraphicsItem(newdialog.GIData.item()));
         _metadata.dialog.data()->push_back(newdialog);
-        _metadata.renewMangaPath_Dialog(_metadata.dialog.data()->size()-1);
+        _polygonIndex[ComicMetadata_Dialog].append(newdialog.GIData);
+        _metadata.markChanged(ComicMetadata_Dialog);
     }
         break;
     case ComicMetadata_Onomatopoeia:
@@ -1203,9 +1445,10 @@ void MainWindow::terminateCreatePolygon()
         OnomatopoeiaData newonomatopoeia;
         newonomatopoeia.GIData.setPolygon(polygon, _image.data()->width(), _image.data()->height());
         newonomatopoeia.GIData.colorDefault();
-        _scene.data()->addItem(newonomatopoeia.GIData.item());
+        _scene.data()->addItem(toGraphicsItem(newonomatopoeia.GIData.item()));
         _metadata.onomatopoeia.data()->push_back(newonomatopoeia);
-        _metadata.renewMangaPath_Onomatopoeia(_metadata.onomatopoeia.data()->size()-1);
+        _polygonIndex[ComicMetadata_Onomatopoeia].append(newonomatopoeia.GIData);
+        _metadata.markChanged(ComicMetadata_Onomatopoeia);
     }
         break;
     case ComicMetadata_Item:
@@ -1213,9 +1456,10 @@ void MainWindow::terminateCreatePolygon()
         ItemData newitem;
         newitem.GIData.setPolygon(polygon, _image.data()->width(), _image.data()->height());
         newitem.GIData.colorDefault();
-        _scene.data()->addItem(newitem.GIData.item());
+        _scene.data()->addItem(toGraphicsItem(newitem.GIData.item()));
         _metadata.item.data()->push_back(newitem);
-        _metadata.renewMangaPath_Item(_metadata.item.data()->size()-1);
+        _polygonIndex[ComicMetadata_Item].append(newitem.GIData);
+        _metadata.markChanged(ComicMetadata_Item);
     }
     default:
         break;
@@ -1677,17 +1921,10 @@ void MainWindow::editModeMouseClick(QPoint pt)
     if(_image.data()->isNull()) return;
     if(!_isEditMode) return;
     QPolygonF polygon = _editModeItem.item()->polygon();
-    double mindistance = calcDistance(QPointF(pt), polygon.at(0));
-    int nearest = 0;
-    for(int i=1; i<polygon.size();i++){
-        double distance = calcDistance(QPointF(pt), polygon.at(i));
-        if(mindistance > distance){
-            mindistance = distance;
-            nearest = i;
-        }
-    }
+    double mindistance = 0;
+    int nearest = findNearestPoint(polygon.constData(), polygon.size(), QPointF(pt), &mindistance);
 
-    if(mindistance < _editCircleSize){
+    if(nearest >= 0 && mindistance < _editCircleSize){
         _nowEditing = true;
         _editCornerNumber = nearest;
     }
@@ -1775,12 +2012,12 @@ void MainWindow::editModeMouseRelease(QPoint pt)
  */
 void MainWindow::editFramePolygon(int number, QPolygonF polygon)
 {
-    if(number < 0 && number >= _metadata.frame.data()->size()){
+    if(number < 0 || number >= _metadata.frame.data()->size()){
         return;
     }
-    FrameData buf = _metadata.frame.data()->at(number);
-    buf.GIData.setPolygon(polygon, _image.data()->width(), _image.data()->height());
-    _metadata.frame.data()->replace(number, buf);
+    GraphicsItemData &GIData = _metadata.editFrame(number).GIData;
+    GIData.setPolygon(polygon, _image.data()->width(), _image.data()->height());
+    _polygonIndex[ComicMetadata_Frame].replace(number, GIData);
 }
 
 /*!
@@ -1791,12 +2028,12 @@ void MainWindow::editFramePolygon(int number, QPolygonF polygon)
  */
 void MainWindow::editCharacterPolygon(int number, QPolygonF polygon)
 {
-    if(number < 0 && number >= _metadata.character.data()->size()){
+    if(number < 0 || number >= _metadata.character.data()->size()){
         return;
     }
-    CharacterData buf = _metadata.character.data()->at(number);
-    buf.GIData.setPolygon(polygon, _image.data()->width(), _image.data()->height());
-    _metadata.character.data()->replace(number, buf);
+    GraphicsItemData &GIData = _metadata.editCharacter(number).GIData;
+    GIData.setPolygon(polygon, _image.data()->width(), _image.data()->height());
+    _polygonIndex[ComicMetadata_Character].replace(number, GIData);
 }
 
 /*!
@@ -1807,12 +2044,12 @@ void MainWindow::editCharacterPolygon(int number, QPolygonF polygon)
  */
 void MainWindow::editDialogPolygon(int number, QPolygonF polygon)
 {
-    if(number < 0 && number >= _metadata.dialog.data()->size()){
+    if(number < 0 || number >= _metadata.dialog.data()->size()){
         return;
     }
-    DialogData buf = _metadata.dialog.data()->at(number);
-    buf.GIData.setPolygon(polygon, _image.data()->width(), _image.data()->height());
-    _metadata.dialog.data()->replace(number, buf);
+    GraphicsItemData &GIData = _metadata.editDialog(number).GIData;
+    GIData.setPolygon(polygon, _image.data()->width(), _image.data()->height());
+    _polygonIndex[ComicMetadata_Dialog].replace(number, GIData);
 }
 
 /*!
@@ -1823,12 +2060,12 @@ void MainWindow::editDialogPolygon(int number, QPolygonF polygon)
  */
 void MainWindow::editOnomatopoeiaPolygon(int number, QPolygonF polygon)
 {
-    if(number < 0 && number >= _metadata.onomatopoeia.data()->size()){
+    if(number < 0 || number >= _metadata.onomatopoeia.data()->size()){
         return;
     }
-    OnomatopoeiaData buf = _metadata.onomatopoeia.data()->at(number);
-    buf.GIData.setPolygon(polygon, _image.data()->width(), _image.data()->height());
-    _metadata.onomatopoeia.data()->replace(number, buf);
+    GraphicsItemData &GIData = _metadata.editOnomatopoeia(number).GIData;
+    GIData.setPolygon(polygon, _image.data()->width(), _image.data()->height());
+    _polygonIndex[ComicMetadata_Onomatopoeia].replace(number, GIData);
 }
 
 /*!
@@ -1839,12 +2076,12 @@ void MainWindow::editOnomatopoeiaPolygon(int number, QPolygonF polygon)
  */
 void MainWindow::editItemPolygon(int number, QPolygonF polygon)
 {
-    if(number < 0 && number >= _metadata.item.data()->size()){
+    if(number < 0 || number >= _metadata.item.data()->size()){
         return;
     }
-    ItemData buf = _metadata.item.data()->at(number);
-    buf.GIData.setPolygon(polygon, _image.data()->width(), _image.data()->height());
-    _metadata.item.data()->replace(number, buf);
+    GraphicsItemData &GIData = _metadata.editItem(number).GIData;
+    GIData.setPolygon(polygon, _image.data()->width(), _image.data()->height());
+    _polygonIndex[ComicMetadata_Item].replace(number, GIData);
 }
 
 
@@ -1937,11 +2174,12 @@ void MainWindow::startSelectMode(ComicMetadataType type)
         break;
     }
 
-    //! 各ポリゴンの面積を計算しておく
-    for(int i=0; i<_selectTarget.size(); i++){
-        GraphicsItemData GIData = _selectTarget.at(i);
-        QPolygonF polygon = GIData.item()->polygon();
-        _selectItemPolygonSizeList.push_back(calcPolygonAreaSize(polygon));
+    //! 当たり判定用の空間インデックスが対象のリストと一致していなければ作り直す（通常は追加・変更・削除時に更新済み）
+    if(type < ComicMetadata_All && _polygonIndex[type].size() != _selectTarget.size()){
+        _polygonIndex[type].clear();
+        for(int i=0; i<_selectTarget.size(); i++){
+            _polygonIndex[type].append(_selectTarget.at(i));
+        }
     }
 
     //! 処理終了
@@ -2014,84 +2252,24 @@ void MainWindow::showAll()
  */
 int MainWindow::selectItem(QPoint mouse)
 {
-    //! 処理開始
-    int nearestNumber = -1;
-    QList<int> onList;
-
-    //! 現在のマウス座標を内包するポリゴンのリストを取得する
-    for(int i=0; i<_selectTarget.size(); i++){
-        GraphicsItemData GIData = _selectTarget.at(i);
-        QPolygonF polygon = GIData.item()->polygon();
-        if(polygon.containsPoint(mouse, Qt::WindingFill)){
-            onList.push_back(i);
-        }
-    }
-
-    //! 現在のマウス座標を内包するポリゴンが複数ある場合に、どれが選択状態となるかを決定する（小さいほう優先）
-    if(onList.size() >= 2){
-        double minArea = _selectItemPolygonSizeList.at(onList.at(0));
-        nearestNumber = onList.at(0);
-        for(int i = 1; i<onList.size(); i++){
-            double areaSize = _selectItemPolygonSizeList.at(onList.at(i));
-            if(minArea > areaSize){
-                minArea = areaSize;
-                nearestNumber = onList.at(i);
-            }
-        }
-    }
-    else if(!onList.isEmpty()){
-        nearestNumber = onList.at(0);
-    }
-    //! 結果を返す
-    return nearestNumber;
-
-    //! 処理終了
+    //! 選択対象の種類の空間インデックスから、マウス座標を内包するポリゴンのうち最も小さいものを取得する
+    //! （マウス座標の近傍のポリゴンのみを判定する）
+    if(_selectTargetType < 0 || _selectTargetType >= ComicMetadata_All) return -1;
+    int selected = _polygonIndex[_selectTargetType].smallestContaining(mouse);
+    if(selected >= _selectTarget.size()) return -1;
+    return selected;
 }
 
 /*!
  * \brief selectItemのターゲット指定付き関数
  * MainWindow::selectItem
- * \param target 対象となるデータ
- * \param sizeList 対象領域の面積リスト
+ * \param index 対象となるデータの当たり判定用インデックス（選択済み等、無視するものは検索対象から外しておく）
  * \param mouse マウス座標
- * \param ignore　無視するインデックスのリスト
  * \return 選択状態にするアイテムのインデックス
  */
-int MainWindow::selectItem(QVector<GraphicsItemData>& target,
-                           QVector<double> &sizeList, QPoint mouse, QVector<int> &ignore)
-{
-    int nearestNumber = -1;
-    QList<int> onList;
-    for(int i=0; i<target.size(); i++){
-        GraphicsItemData GIData = target.at(i);
-        QPolygonF polygon = GIData.item()->polygon();
-        bool status = true;
-        //今回の処理対象が無視リストに入っている場合にはonListへの追加処理を行わない
-        for(int j=0; j<ignore.size(); j++){
-            if(i == ignore.at(j)){
-                status = false;
-            }
-        }
-        if(status && polygon.containsPoint(mouse, Qt::WindingFill)){
-            onList.push_back(i);
-        }
-    }
-
-    if(onList.size() >= 2){
-        double minArea = sizeList.at(onList.at(0));
-        nearestNumber = onList.at(0);
-        for(int i = 1; i<onList.size(); i++){
-            double areaSize = sizeList.at(onList.at(i));
-            if(minArea > areaSize){
-                minArea = areaSize;
-                nearestNumber = onList.at(i);
-            }
-        }
-    }
-    else if(!onList.isEmpty()){
-        nearestNumber = onList.at(0);
-    }
-    return nearestNumber;
+int MainWindow::selectItem(const PolygonGridIndex &index, QPoint mouse)
+{
+    return index.smallestContaining(mouse);
 }
 
 /*!
@@ -2266,16 +2444,17 @@ void MainWindow::removeFrame(int number)
     //! 処理開始
     //! 範囲外が指定された場合には何もせず終了
     if(number < 0) return;
-    if(number > _metadata.frame.data()->size()) return;
+    if(number >= _metadata.frame.data()->size()) return;
 
     //! 削除処理
     GraphicsItemData GIData;
     GIData = _metadata.frame.data()->at(number).GIData;
-    _scene.data()->removeItem(GIData.item());
-    _metadata.deleteItem(ComicMetadata_Frame, number);//消去時には一つずらす
+    _scene.data()->removeItem(toGraphicsItem(GIData.item()));
+    _metadata.deleteItem(ComicMetadata_Frame, number);//消去時には一つずらす（各注釈の対象コマも更新される）
+    _polygonIndex[ComicMetadata_Frame].removeAt(number);
 
-    //! コマのリストを最新の状態に変更する
-    refresh_Frame_ListWidget();
+    //! 各注釈の対象コマの番号も変わるため全てのリストを最新の状態に変更する
+    refresh_ALL_ListWidget();
 
     //! 選択状態となるコマを変更する
     if(number == 1 && !_metadata.frame.data()->isEmpty()){
@@ -2306,8 +2485,9 @@ void MainWindow::removeCharacter(int number)
     //! 削除処理
     GraphicsItemData GIData;
     GIData = _metadata.character.data()->at(number).GIData;
-    _scene.data()->removeItem(GIData.item());
+    _scene.data()->removeItem(toGraphicsItem(GIData.item()));
     _metadata.deleteItem(ComicMetadata_Character, number);
+    _polygonIndex[ComicMetadata_Character].removeAt(number);
 
     //! 登場人物のリストを最新の状態に変更する
     refresh_Character_ListWidget();
@@ -2337,8 +2517,9 @@ void MainWindow::removeDialog(int number)
     //! 削除処理
     GraphicsItemData GIData;
     GIData = _metadata.dialog.data()->at(number).GIData;
-    _scene.data()->removeItem(GIData.item());
+    _scene.data()->removeItem(toGraphicsItem(GIData.item()));
     _metadata.deleteItem(ComicMetadata_Dialog, number);
+    _polygonIndex[ComicMetadata_Dialog].removeAt(number);
 
     //! セリフのリストを最新の状態に変更する
     refresh_Dialog_ListWidget();
@@ -2368,8 +2549,9 @@ void MainWindow::removeOnomatopoeia(int number)
     //! 削除処理
     GraphicsItemData GIData;
     GIData = _metadata.onomatopoeia.data()->at(number).GIData;
-    _scene.data()->removeItem(GIData.item());
+    _scene.data()->removeItem(toGraphicsItem(GIData.item()));
     _metadata.deleteItem(ComicMetadata_Onomatopoeia, number);
+    _polygonIndex[ComicMetadata_Onomatopoeia].removeAt(number);
 
     //! オノマトペのリストを最新の状態に変更する
     refresh_Onomatopoeia_ListWidget();
@@ -2400,8 +2582,9 @@ void MainWindow::removeCItem(int number)
     //! 削除処理
     GraphicsItemData GIData;
     GIData = _metadata.item.data()->at(number).GIData;
-    _scene.data()->removeItem(GIData.item());
+    _scene.data()->removeItem(toGraphicsItem(GIData.item()));
     _metadata.deleteItem(ComicMetadata_Item, number);
+    _polygonIndex[ComicMetadata_Item].removeAt(number);
 
     //! アイテムのリストを最新の状態に変更する
     refresh_Item_ListWidget();
@@ -2423,7 +2606,6 @@ void MainWindow::selectModeCancel()
 {
     _isSelectMode = false;
     _selectTarget.clear();
-    _selectItemPolygonSizeList.clear();
     _selectedItemNumber = -1;
     _selectLock = false;
 
@@ -2493,20 +2675,21 @@ void MainWindow::on_functionTab_currentChanged(int index)
  * \brief コマを追加する処理
  * MainWindow::addFrame
  * \param polygon ポリゴン情報
- * \param mangaPath マンガパス
  * \param sceneBoundery シーン切り替え情報
  */
 void MainWindow::addFrame
-(QPolygonF polygon, QString mangaPath, bool sceneBoundery)
+(QPolygonF polygon, bool sceneBoundery)
 {
+    STAGE_TRACE("addFrame");
     //! 新規エントリ作成とセット
     FrameData newframe;
     newframe.GIData.setPolygon(polygon, _image.data()->width(), _image.data()->height());
     newframe.GIData.colorDefault();
-    newframe.mangaPath = mangaPath;
     newframe.sceneBoundary = sceneBoundery;
-    _scene.data()->addItem(newframe.GIData.item());
+    _scene.data()->addItem(toGraphicsItem(newframe.GIData.item()));
     _metadata.frame.data()->push_back(newframe);
+    _polygonIndex[ComicMetadata_Frame].append(newframe.GIData);
+    _metadata.markChanged(ComicMetadata_Frame);
 
     int size = _metadata.frame.data()->size();
     QString itemName(QString("ID:%1 Frame").arg(size));
@@ -2514,32 +2697,32 @@ void MainWindow::addFrame
 
     //!表示情報を最新の状態に変更する
     refresh_Frame_ListWidget();
-    _metadata.renewMangaPath_Frame(_metadata.frame.data()->size()-1);
 }
 
 /*!
  * \brief 登場人物の追加処理
  * MainWindow::addCharacter
  * \param polygon ポリゴン情報
- * \param mangaPath マンガパス
  * \param characterName 登場人物名
  * \param characterID 登場人物ID
  * \param targetFrame 対応するコマのインデックス
  */
 void MainWindow::addCharacter
-(QPolygonF polygon, QString mangaPath,
+(QPolygonF polygon,
  QString characterName, int characterID, int targetFrame)
 {
+    STAGE_TRACE("addCharacter");
     //! 新規エントリ作成とセット
     CharacterData newCharacter;
     newCharacter.GIData.setPolygon(polygon, _image.data()->width(), _image.data()->height());
     newCharacter.GIData.colorDefault();
-    newCharacter.mangaPath = mangaPath;
     newCharacter.characterName = characterName;
     newCharacter.characterID = characterID;
     newCharacter.targetFrame = targetFrame;
-    _scene.data()->addItem(newCharacter.GIData.item());
+    _scene.data()->addItem(toGraphicsItem(newCharacter.GIData.item()));
     _metadata.character.data()->push_back(newCharacter);
+    _polygonIndex[ComicMetadata_Character].append(newCharacter.GIData);
+    _metadata.markChanged(ComicMetadata_Character);
 
     //コメントアウトの理由忘却 FIXME!
     //あとでcreate character name という様な関数を作って統一したい FIXME!
@@ -2548,7 +2731,6 @@ void MainWindow::addCharacter
     //ui->ListWidget_Character->addItem(itemName);
 
     //!表示情報を最新の状態に変更する
-    _metadata.renewMangaPath_Character(_metadata.character.data()->size()-1);
     refresh_Character_ListWidget();
 }
 
@@ -2556,7 +2738,6 @@ void MainWindow::addCharacter
  * \brief セリフの追加処理
  * MainWindow::addDialog
  * \param polygon ポリゴン情報
- * \param mangaPath マンガパス
  * \param text セリフ内容
  * \param fontsize フォントサイズ
  * \param narration ナレーションかどうかのフラグ
@@ -2565,14 +2746,14 @@ void MainWindow::addCharacter
  * \param characterName 対応する登場人物名
  */
 void MainWindow::addDialog
-(QPolygonF polygon, QString mangaPath, QString text,
+(QPolygonF polygon, QString text,
  int fontsize, bool narration, int targetCharacterID,
  int targetFrame, QString characterName)
 {
+    STAGE_TRACE("addDialog");
     //! 新規エントリ作成とセット
     DialogData newDialog;
     newDialog.GIData.setPolygon(polygon, _image.data()->width(), _image.data()->height());
-    newDialog.mangaPath = mangaPath;
     newDialog.GIData.colorDefault();
     newDialog.fontSize = fontsize;
     newDialog.narration = narration;
@@ -2580,11 +2761,12 @@ void MainWindow::addDialog
     newDialog.characterName = characterName;
     newDialog.targetFrame = targetFrame;
     newDialog.text = text;
-    _scene.data()->addItem(newDialog.GIData.item());
+    _scene.data()->addItem(toGraphicsItem(newDialog.GIData.item()));
     _metadata.dialog.data()->push_back(newDialog);
+    _polygonIndex[ComicMetadata_Dialog].append(newDialog.GIData);
+    _metadata.markChanged(ComicMetadata_Dialog);
 
     //!表示情報を最新の状態に変更する
-    _metadata.renewMangaPath_Dialog(_metadata.dialog.data()->size()-1);
     refresh_Dialog_ListWidget();
 }
 
@@ -2592,25 +2774,26 @@ void MainWindow::addDialog
  * \brief オノマトペの追加処理
  * MainWindow::addOnomatopoeia
  * \param polygon ポリゴン情報
- * \param mangaPath マンガパス
  * \param text オノマトペの内容
  * \param fontsize フォントサイズ
  * \param targetFrame 対応するコマのインデックス
  */
 void MainWindow::addOnomatopoeia
-(QPolygonF polygon, QString mangaPath, QString text,
+(QPolygonF polygon, QString text,
  int fontsize, bool targetFrame)
 {
+    STAGE_TRACE("addOnomatopoeia");
     //! 新規エントリ作成とセット
     OnomatopoeiaData newOnomatopoeia;
     newOnomatopoeia.GIData.setPolygon(polygon, _image.data()->width(), _image.data()->height());
-    newOnomatopoeia.mangaPath = mangaPath;
     newOnomatopoeia.GIData.colorDefault();
     newOnomatopoeia.fontSize = fontsize;
     newOnomatopoeia.targetFrame = targetFrame;
     newOnomatopoeia.text = text;
-    _scene.data()->addItem(newOnomatopoeia.GIData.item());
+    _scene.data()->addItem(toGraphicsItem(newOnomatopoeia.GIData.item()));
     _metadata.onomatopoeia.data()->push_back(newOnomatopoeia);
+    _polygonIndex[ComicMetadata_Onomatopoeia].append(newOnomatopoeia.GIData);
+    _metadata.markChanged(ComicMetadata_Onomatopoeia);
 
     //コメントアウトの理由忘却 FIXME!
     //int size = _metadata.onomatopoeia.data()->size();
@@ -2618,7 +2801,6 @@ void MainWindow::addOnomatopoeia
     //ui->ListWidget_Onomatopoeia->addItem(itemName);
 
     //!表示情報を最新の状態に変更する
-    _metadata.renewMangaPath_Onomatopoeia(_metadata.onomatopoeia.data()->size()-1);
     refresh_Onomatopoeia_ListWidget();
 }
 
@@ -2626,25 +2808,26 @@ void MainWindow::addOnomatopoeia
  * \brief アイテムの追加処理
  *  MainWindow::addItem
  * \param polygon ポリゴン情報
- * \param mangaPath マンガパス
  * \param itemClass アイテムの属性
  * \param description　記述内容
  * \param targetFrame 対応するコマのインデックス
  */
 void MainWindow::addItem
-(QPolygonF polygon, QString mangaPath, QString itemClass,
+(QPolygonF polygon, QString itemClass,
  QString description, int targetFrame)
 {
+    STAGE_TRACE("addItem");
     //! 新規エントリ作成とセット
     ItemData newItem;
     newItem.GIData.setPolygon(polygon, _image.data()->width(), _image.data()->height());
     newItem.GIData.colorDefault();
-    newItem.mangaPath = mangaPath;
     newItem.itemClass = itemClass;
     newItem.description = description;
     newItem.targetFrame = targetFrame;
-    _scene.data()->addItem(newItem.GIData.item());
+    _scene.data()->addItem(toGraphicsItem(newItem.GIData.item()));
     _metadata.item.data()->push_back(newItem);
+    _polygonIndex[ComicMetadata_Item].append(newItem.GIData);
+    _metadata.markChanged(ComicMetadata_Item);
 
     //コメントアウトの理由忘却 FIXME!
     //int size = _metadata.item.data()->size();
@@ -2652,7 +2835,6 @@ void MainWindow::addItem
     //ui->ListWidget_CItem->addItem(itemName);
 
     //!表示情報を最新の状態に変更する
-    _metadata.renewMangaPath_Item(_metadata.item.data()->size()-1);
     refresh_Item_ListWidget();
 }
 
@@ -2727,8 +2909,7 @@ void MainWindow::showOrder(QVector<GraphicsItemData> GIData)
         int number = i+1;
 
         //! - 数字の表示場所を計算する
-        QPolygonF polygon = GIData.at(i)._item->polygon();
-        QPointF center = getPolygonCenter(polygon);
+        QPointF center = GIData.at(i).center();
         center.setX(center.x() - 30);
         center.setY(center.y() - 30);
         int digit = (int)log10(i) + 1;
@@ -2896,13 +3077,11 @@ void MainWindow::on_ListWidget_Dialog_currentItemChanged(QListWidgetItem *curren
 void MainWindow::on_TextEdit_Dialog_textChanged()
 {
     //! 選択されているDialogアイテムの番号が正しいかチェック
-    if(_currentDialogNumber < 0 || _metadata.dialog.data()->size() < _currentDialogNumber){
+    if(_currentDialogNumber < 0 || _metadata.dialog.data()->size() <= _currentDialogNumber){
         return;
     }
-    //! 新しいデータを作成し、選択されているデータと入れ替える
-    DialogData newData = _metadata.dialog.data()->at(_currentDialogNumber);
-    newData.text = ui->TextEdit_Dialog->document()->toPlainText();
-    _metadata.dialog.data()->replace(_currentDialogNumber, newData);
+    //! 選択されているデータのテキストのみを書き換える
+    _metadata.editDialog(_currentDialogNumber).text = ui->TextEdit_Dialog->document()->toPlainText();
 
 //    refresh_Dialog_ListWidget(_currentDialogNumber);
 }
@@ -2945,8 +3124,7 @@ void MainWindow::on_TextEdit_Onomatopoeia_textChanged()
             || _currentOnomatopoeiaNumber >= _metadata.onomatopoeia.data()->size()){
         return;
     }
-    _currentOnomatopoeia.text = ui->TextEdit_Onomatopoeia->document()->toPlainText();
-    _metadata.onomatopoeia.data()->replace(_currentOnomatopoeiaNumber, _currentOnomatopoeia);
+    _metadata.editOnomatopoeia(_currentOnomatopoeiaNumber).text = ui->TextEdit_Onomatopoeia->document()->toPlainText();
 //    refresh_Onomatopoeia_ListWidget(_currentOnomatopoeiaNumber);
 }
 
@@ -2982,7 +3160,7 @@ void MainWindow::specifyFrame(int number)
     GIData.colorSelected();
 
     ui->Delete_Frame->setEnabled(true);
-    ui->Frame_MangaPath->setText(_metadata.frame.data()->at(number).mangaPath);
+    ui->Frame_MangaPath->setText(_metadata.mangaPath(ComicMetadata_Frame, number));
     ui->Frame_SceneChange_CheckBox->setChecked(_metadata.frame.data()->at(number).sceneBoundary);
     ui->Frame_SceneChange_CheckBox->setEnabled(true);
     _currentFrameNumber = number;
@@ -3049,7 +3227,7 @@ void MainWindow::specifyCharacter(int number)
     ui->Character_FrameComboBox->setCurrentIndex(_metadata.character.data()->at(number).targetFrame);
     ui->Character_FrameComboBox->setEnabled(true);
     ui->Character_MangaPath->setText(
-                _metadata.character.data()->at(number).mangaPath);
+                _metadata.mangaPath(ComicMetadata_Character, number));
     _currentCharacterNumber = number;
     _isSpecifyed = false;
 }
@@ -3124,7 +3302,7 @@ void MainWindow::specifyDialog(int number)
     _currentDialogNumber = number;
     _selectedItemNumber = number;
     ui->Dialog_MangaPath->setText(
-                _metadata.dialog.data()->at(number).mangaPath);
+                _metadata.mangaPath(ComicMetadata_Dialog, number));
 
 }
 
@@ -3176,14 +3354,14 @@ void MainWindow::specifyOnomatopoeia(int number)
     _selectLock = true;
     GIData.colorSelected();
     _currentOnomatopoeiaNumber = number;
-    _currentOnomatopoeia = _metadata.onomatopoeia.data()->at(number);
     _selectedItemNumber = number;
-    ui->TextEdit_Onomatopoeia->setText(_currentOnomatopoeia.text);
+    int targetFrame = _metadata.onomatopoeia.data()->at(number).targetFrame;
+    ui->TextEdit_Onomatopoeia->setText(_metadata.onomatopoeia.data()->at(number).text);
     ui->Onomatopoeia_FrameComboBox->setEnabled(true);
-    ui->Onomatopoeia_FrameComboBox->setCurrentIndex(_currentOnomatopoeia.targetFrame);
+    ui->Onomatopoeia_FrameComboBox->setCurrentIndex(targetFrame);
     ui->TextEdit_Onomatopoeia->setEnabled(true);
     ui->Onomatopoeia_MangaPath->setText(
-                _metadata.onomatopoeia.data()->at(number).mangaPath);
+                _metadata.mangaPath(ComicMetadata_Onomatopoeia, number));
 
 }
 
@@ -3234,7 +3412,7 @@ void MainWindow::specifyItem(int number)
     ui->Item_FrameComboBox->setCurrentIndex(_currentItem.targetFrame);
     ui->Item_FrameComboBox->setEnabled(true);
     ui->Item_MangaPath->setText(
-                _metadata.item.data()->at(number).mangaPath);
+                _metadata.mangaPath(ComicMetadata_Item, number));
 }
 
 /*!
@@ -3267,14 +3445,13 @@ void MainWindow::on_DialogType_Dialog_clicked()
     if(_currentDialogNumber >= _metadata.dialog.data()->size() || _currentDialogNumber < 0){
         return;
     }
-    DialogData newDialog = _metadata.dialog.data()->at(_currentDialogNumber);
     ui->DialogType_Dialog->setChecked(true);
     ui->DialogType_Narration->setChecked(false);
-    newDialog.narration = false;
-    newDialog.characterName = "--";
-    newDialog.targetCharacterID = 0;
+    DialogData &dialog = _metadata.editDialog(_currentDialogNumber);
+    dialog.narration = false;
+    dialog.characterName = "--";
+    dialog.targetCharacterID = 0;
     ui->Dialog_SpeakerComboBox->setEnabled(true);
-    _metadata.dialog.data()->replace(_currentDialogNumber, newDialog);
 
     refresh_Dialog_ListWidget(_currentDialogNumber);
 }
@@ -3293,12 +3470,11 @@ void MainWindow::on_DialogType_Narration_clicked()
     }
     ui->DialogType_Dialog->setChecked(false);
     ui->DialogType_Narration->setChecked(true);
-    DialogData newDialog = _metadata.dialog.data()->at(_currentDialogNumber);
-    newDialog.narration = true;
-    newDialog.characterName = "Narration";
+    DialogData &dialog = _metadata.editDialog(_currentDialogNumber);
+    dialog.narration = true;
+    dialog.characterName = "Narration";
     ui->Dialog_SpeakerComboBox->setEnabled(false);
     ui->Dialog_SpeakerComboBox->setCurrentIndex(-1);
-    _metadata.dialog.data()->replace(_currentDialogNumber, newDialog);
     refresh_Dialog_ListWidget(_currentDialogNumber);
 }
 
@@ -3358,7 +3534,9 @@ void MainWindow::initListWidget_Frame()
  */
 void MainWindow::on_actionSaveMetaData_triggered()
 {
+    //!明示的な保存ではジャーナルの内容もXMLファイルへ反映する
     writeMetaData();
+    _pdata.data()->_saveQueue.checkpoint();
 }
 
 /*!
@@ -3367,15 +3545,22 @@ void MainWindow::on_actionSaveMetaData_triggered()
  * 現時点では基本すべて上書き
  * 初めにCommonメタデータを出力する
  * 次に該当するページメタデータを出力する
+ * 実際の書き込みはMetadataSaveQueueのスレッドで行い、失敗した場合はステータスバーに表示する
+ * （一旦ジャーナルに追記され、XMLファイルへはチェックポイントで反映される）
  * \return
  */
 bool MainWindow::writeMetaData()
 {
+    STAGE_TRACE("writeMetaData");
     QFileInfo imageFileName = QFileInfo(_fileUtility.getCurrentFileName());
 
     //ファイルが開かれていない場合には何もせず終了
     if(imageFileName.absoluteFilePath().size() <= 0) return false;
 
+    //値を変えずに書き戻されただけの箇所は変更無しとし、変更が無ければ何も書き込まない
+    _metadata.dropUnchangedFlags();
+    if(!_metadata.isChanged()) return true;
+
     QDir dir = imageFileName.absoluteDir();
 
 //Windows Mac Linux
@@ -3399,18 +3584,27 @@ bool MainWindow::writeMetaData()
     //! 共通メタデータのファイル名を設定
     QString commonXMLFileName = QString("%1/ComicMetadata.xml").arg(metadataDir.absolutePath());
 
-    //! 共通メタデータを出力する
-    _metadata.writeMetadata_Common(commonXMLFileName);
-
     //! ページメタデータのファイル名を設定
     QString pageXMLFileName = QString("%1/").arg(metadataDir.absolutePath());
     pageXMLFileName += QString("%1.xml").arg(imageFileName.baseName());
 
-    //! ページメタデータを出力する
-    _metadata.writeMetadata_Page(pageXMLFileName);
+    //! 現時点のメタデータの複製を保存キューに渡す（書き込みはバックグラウンドで行う）
+    //! 変更の有った方のみを出力する
+    QSharedPointer<ComicMetadata> snapshot = _metadata.clone();
+    if(_metadata.isCommonChanged()){
+        _pdata.data()->_saveQueue.enqueue(commonXMLFileName, MetadataSaveQueue::Save_Common, snapshot);
+
+        //!保存した内容を共通メタデータのキャッシュとする
+        _pdata.data()->_commonCacheFileName = QFileInfo(commonXMLFileName).absoluteFilePath();
+        _pdata.data()->_commonCacheStamp = QFileInfo(commonXMLFileName).lastModified();
+        _pdata.data()->_commonCacheTitle = _metadata.workTitle;
+        _pdata.data()->_commonCacheCharacterName = _metadata.characterName;
+    }
+    if(_metadata.isPageChanged()){
+        _pdata.data()->_saveQueue.enqueue(pageXMLFileName, MetadataSaveQueue::Save_Page, snapshot);
+    }
 
-    _commonMetadataEdit = false;
-    _pageMetadataEdit = false;
+    _metadata.clearChanged();
     return true;
 }
 
@@ -3433,6 +3627,7 @@ void MainWindow::on_AddNewCharacter_PushButton_clicked()
     else{
         _metadata.characterName.push_back(ui->Info_NewCharacterName_LineEdit->text());
     }
+    _metadata.markCommonChanged();
     cout << "addCharacter" << _metadata.characterName.size() << endl;
     ui->Info_NewCharacterName_LineEdit->clear();
     resetCharacterList();
@@ -3481,6 +3676,7 @@ void MainWindow::deleteCharacterList(int number)
     //デフォルト：0番は消さない
     if(number < _metadata.characterName.size() && number > 0){
         _metadata.characterName.removeAt(number);
+        _metadata.markCommonChanged();
         resetCharacterList();
         if(number >= _metadata.characterName.size()) --number;
         ui->Info_CharacterListWidget->setCurrentRow(number);
@@ -3494,12 +3690,16 @@ void MainWindow::deleteCharacterList(int number)
  */
 void MainWindow::resetCharacterList()
 {
-    ui->Info_CharacterListWidget->clear();
     QString name;
     QVector<QString> nameList;
     //!ID番号付きの名前リストを作成する
     if(_metadata.characterName.isEmpty()) initCharacterList();
 
+    //!表示中のリストと同じであれば、ウィジェットは作り直さない
+    if(_metadata.characterName == _shownCharacterName) return;
+    _shownCharacterName = _metadata.characterName;
+    ui->Info_CharacterListWidget->clear();
+
     for(int i=0; i<_metadata.characterName.size(); i++){
         name = QString("ID:%1 ").arg(i, 3, 10, QChar('0'));
         name += _metadata.characterName.at(i);
@@ -3526,6 +3726,7 @@ void MainWindow::resetCharacterList()
 void MainWindow::initCharacterList()
 {
     _metadata.clearCharacterName();
+    _metadata.markCommonChanged();
     resetCharacterList();
 }
 
@@ -3554,6 +3755,7 @@ void MainWindow::on_Info_SelectedCharacterRename_clicked()
     //!通常のリネーム処理
     _metadata.characterName.replace
             (_selectedCharacterNameNumber, ui->Info_SelectedCharacterName->text());
+    _metadata.markCommonChanged();
     resetCharacterList();
     return;
 }
@@ -3570,13 +3772,10 @@ void MainWindow::on_Character_ComboBox_currentIndexChanged(int index)
             || _currentCharacterNumber >= _metadata.character.data()->size()) return;
     if(index < 0 || index >= _metadata.characterName.size()) return;
 
-    //! 選択されたデータを取得する
-    CharacterData character_buff = _metadata.character.data()->at(_currentCharacterNumber);
-    character_buff.characterID = index;
-    character_buff.characterName = _metadata.characterName.at(index);
-
-    //! 現在のデータで置き換える
-    _metadata.character.data()->replace(_currentCharacterNumber, character_buff);
+    //! 選択されたデータを直接書き換える
+    CharacterData &character = _metadata.editCharacter(_currentCharacterNumber);
+    character.characterID = index;
+    character.characterName = _metadata.characterName.at(index);
     if(!_isRefreshingNow && !_isSpecifyed){
         refresh_Character_ListWidget(_currentCharacterNumber);
     }
@@ -3606,12 +3805,9 @@ void MainWindow::on_Character_FrameComboBox_currentIndexChanged(int index)
             || _currentCharacterNumber >= _metadata.character.data()->size()) return;
     if(index < 0 || index > _metadata.frame.data()->size()) return;
 
-    CharacterData buff = _metadata.character.data()->at(_currentCharacterNumber);
-    buff.targetFrame = index;
-    _metadata.character.data()->replace(_currentCharacterNumber, buff);
-    _metadata.renewMangaPath_Character(_currentCharacterNumber);
+    _metadata.editCharacter(_currentCharacterNumber).targetFrame = index;
     ui->Character_MangaPath->setText(
-                _metadata.character.data()->at(_currentCharacterNumber).mangaPath);
+                _metadata.mangaPath(ComicMetadata_Character, _currentCharacterNumber));
     if(!_isRefreshingNow && !_isSpecifyed){
         refresh_Character_ListWidget(_currentCharacterNumber);
     }
@@ -3628,12 +3824,9 @@ void MainWindow::on_Dialog_FrameComboBox_currentIndexChanged(int index)
             || _currentDialogNumber >= _metadata.dialog.data()->size()) return;
     if(index < 0 || index > _metadata.frame.data()->size()) return;
 
-    DialogData buff = _metadata.dialog.data()->at(_currentDialogNumber);
-    buff.targetFrame = index;
-    _metadata.dialog.data()->replace(_currentDialogNumber, buff);
-    _metadata.renewMangaPath_Dialog(_currentDialogNumber);
+    _metadata.editDialog(_currentDialogNumber).targetFrame = index;
     ui->Dialog_MangaPath->setText(
-                _metadata.dialog.data()->at(_currentDialogNumber).mangaPath);
+                _metadata.mangaPath(ComicMetadata_Dialog, _currentDialogNumber));
     if(!_isRefreshingNow){
         refresh_Dialog_ListWidget(_currentDialogNumber);
     }
@@ -3651,14 +3844,12 @@ void MainWindow::on_Dialog_SpeakerComboBox_currentIndexChanged(int index)
             || _currentDialogNumber >= _metadata.dialog.data()->size()) return;
     if(index < 0 || index >= _metadata.characterName.size()) return;
 
-    DialogData buff = _metadata.dialog.data()->at(_currentDialogNumber);
-    if(buff.narration) return;
-    buff.targetCharacterID = index;
-    buff.characterName = _metadata.characterName.at(index);
-    _metadata.dialog.data()->replace(_currentDialogNumber, buff);
-    _metadata.renewMangaPath_Dialog(_currentDialogNumber);
+    if(_metadata.dialog.data()->at(_currentDialogNumber).narration) return;
+    DialogData &dialog = _metadata.editDialog(_currentDialogNumber);
+    dialog.targetCharacterID = index;
+    dialog.characterName = _metadata.characterName.at(index);
     ui->Dialog_MangaPath->setText(
-                _metadata.dialog.data()->at(_currentDialogNumber).mangaPath);
+                _metadata.mangaPath(ComicMetadata_Dialog, _currentDialogNumber));
     if(!_isRefreshingNow){
         refresh_Dialog_ListWidget(_currentDialogNumber);
     }
@@ -3702,9 +3893,7 @@ void MainWindow::on_Item_Class_LineEdit_textChanged(const QString &arg1)
     if(_currentCItemNumber < 0 || _metadata.item.data()->size() <= _currentCItemNumber){
         return;
     }
-    ItemData buff = _metadata.item.data()->at(_currentCItemNumber);
-    buff.itemClass = ui->Item_Class_LineEdit->text();
-    _metadata.item.data()->replace(_currentCItemNumber, buff);
+    _metadata.editItem(_currentCItemNumber).itemClass = ui->Item_Class_LineEdit->text();
 }
 
 /*!
@@ -3716,9 +3905,7 @@ void MainWindow::on_TextEdit_CItem_textChanged()
     if(_currentCItemNumber < 0 || _metadata.item.data()->size() <= _currentCItemNumber){
         return;
     }
-    ItemData buff = _metadata.item.data()->at(_currentCItemNumber);
-    buff.description = ui->TextEdit_CItem->document()->toPlainText();
-    _metadata.item.data()->replace(_currentCItemNumber, buff);
+    _metadata.editItem(_currentCItemNumber).description = ui->TextEdit_CItem->document()->toPlainText();
 //    refresh_Item_ListWidget();
 }
 
@@ -3733,12 +3920,9 @@ void MainWindow::on_Item_FrameComboBox_currentIndexChanged(int index)
         return;
     }
     if(index < 0 || index > _metadata.frame.data()->size()) return;
-    ItemData buff = _metadata.item.data()->at(_currentCItemNumber);
-    buff.targetFrame = index;
-    _metadata.item.data()->replace(_currentCItemNumber, buff);
-    _metadata.renewMangaPath_Item(_currentCItemNumber);
+    _metadata.editItem(_currentCItemNumber).targetFrame = index;
     ui->Item_MangaPath->setText(
-                _metadata.item.data()->at(_currentCItemNumber).mangaPath);
+                _metadata.mangaPath(ComicMetadata_Item, _currentCItemNumber));
     if(!_isRefreshingNow){
         refresh_Item_ListWidget();
     }
@@ -3765,12 +3949,9 @@ void MainWindow::on_Onomatopoeia_FrameComboBox_currentIndexChanged(int index)
             || _currentOnomatopoeiaNumber >= _metadata.onomatopoeia.data()->size()) return;
     if(index < 0 || index > _metadata.frame.data()->size()) return;
 
-    OnomatopoeiaData buff = _metadata.onomatopoeia.data()->at(_currentOnomatopoeiaNumber);
-    buff.targetFrame = index;
-    _metadata.onomatopoeia.data()->replace(_currentOnomatopoeiaNumber, buff);
-    _metadata.renewMangaPath_Onomatopoeia(_currentOnomatopoeiaNumber);
+    _metadata.editOnomatopoeia(_currentOnomatopoeiaNumber).targetFrame = index;
     ui->Onomatopoeia_MangaPath->setText(
-                _metadata.onomatopoeia.data()->at(_currentOnomatopoeiaNumber).mangaPath);
+                _metadata.mangaPath(ComicMetadata_Onomatopoeia, _currentOnomatopoeiaNumber));
     if(!_isRefreshingNow){
         refresh_Onomatopoeia_ListWidget(_currentOnomatopoeiaNumber);
     }
@@ -3820,7 +4001,10 @@ void MainWindow::on_Item_DelereButton_clicked()
 void MainWindow::on_Info_ComicTitle_LineEdit_textChanged(const QString &arg1)
 {
     _metadata.workTitle = arg1;
-    _metadata.renewAllMangaPath();
+    _metadata.markCommonChanged();
+    //マンガパス式は作品名から導出してページメタデータに書き込むため、ページも変更扱いとする
+    //（実際に変わっていない部分は、保存時にdropUnchangedFlagsで除外される）
+    _metadata.markChanged(ComicMetadata_All);
 }
 
 /*!
@@ -3830,6 +4014,7 @@ void MainWindow::on_Info_ComicTitle_LineEdit_textChanged(const QString &arg1)
  */
 void MainWindow::on_Info_EpisodeNumber_LineEdit_textChanged(const QString &arg1)
 {
+    _metadata.markPageInfoChanged();
     if(arg1.isEmpty()){
         _metadata.episodeNumber = -1;
         ui->Info_EpisodeNumber_LineEdit->clear();
@@ -3839,7 +4024,6 @@ void MainWindow::on_Info_EpisodeNumber_LineEdit_textChanged(const QString &arg1)
     int num = arg1.toInt();
     if(num >= 0){
         _metadata.episodeNumber = num;
-        _metadata.renewAllMangaPath();
     }
     else{
         _metadata.episodeNumber = -1;
@@ -3855,7 +4039,7 @@ void MainWindow::on_Info_EpisodeNumber_LineEdit_textChanged(const QString &arg1)
 void MainWindow::on_Info_PageNumber_textChanged(const QString &arg1)
 {
     _metadata.pageNumber = arg1.toInt();
-    _metadata.renewAllMangaPath();
+    _metadata.markPageInfoChanged();
 }
 
 /*!
@@ -3900,29 +4084,78 @@ void MainWindow::clearMetadata()
  */
 void MainWindow::loadMetadata()
 {
-    _commonMetadataEdit = true;
-    _pageMetadataEdit = true;
-
+    STAGE_TRACE("loadMetadata");
     QFileInfo imageFileName = QFileInfo(_fileUtility.getCurrentFileName());
 
     //!画像ファイルが開かれていない場合には何もせず終了
     if(imageFileName.absoluteFilePath().size() <= 0) return;
 
     _metadata.clear();
+    clearPolygonIndex();
 
     //!Common Metadataを開く
     QDir dir_base = imageFileName.absoluteDir();
     QDir dir(QString("%1/%2").arg(dir_base.absolutePath()).arg(_metadataDirectoryName));
+    int recovered = _pdata.data()->_saveQueue.openDirectory(dir.absolutePath());
+    if(recovered > 0){
+        setStatusBarMessage(tr("recovered %1 metadata file(s) from the journal").arg(recovered));
+    }
     QString commonXMLFileName = QString("%1/ComicMetadata.xml").arg(dir.absolutePath());
-    if(_metadata.loadMetadata_Common(commonXMLFileName)){
-        ui->Info_ComicTitle_LineEdit->setText(_metadata.workTitle);
+    _pdata.data()->_saveQueue.waitFor(commonXMLFileName);
+
+    //!前回読み込んだ共通メタデータから更新されていなければ、キャッシュを使用する
+    //本アプリケーション自身による書き込みでの更新日時の変化は、更新とみなさない
+    MainWindowPrivateData *pdata = _pdata.data();
+    QDateTime commonStamp = QFileInfo(commonXMLFileName).lastModified();
+    QDateTime writtenStamp = pdata->_saveQueue.writtenStamp(commonXMLFileName);
+    bool commonCached = pdata->_commonCacheFileName == QFileInfo(commonXMLFileName).absoluteFilePath()
+            && (pdata->_commonCacheStamp == commonStamp
+                || (writtenStamp.isValid() && writtenStamp == commonStamp));
+
+    QByteArray journaled;
+    bool commonLoaded;
+    if(commonCached){
+        _metadata.workTitle = pdata->_commonCacheTitle;
+        _metadata.characterName = pdata->_commonCacheCharacterName;
+        pdata->_commonCacheStamp = commonStamp;
+        commonLoaded = true;
+    }
+    else{
+        //!ジャーナルにXMLファイルへ未反映の内容が有れば、そちらを読み込む
+        if(pdata->_saveQueue.latestContent(commonXMLFileName, journaled)){
+            QBuffer buffer(&journaled);
+            buffer.open(QIODevice::ReadOnly);
+            commonLoaded = _metadata.loadMetadata_Common(&buffer);
+        }
+        else{
+            commonLoaded = _metadata.loadMetadata_Common(commonXMLFileName);
+        }
+        pdata->_commonCacheFileName = commonLoaded ? QFileInfo(commonXMLFileName).absoluteFilePath() : QString();
+        pdata->_commonCacheStamp = commonStamp;
+        pdata->_commonCacheTitle = _metadata.workTitle;
+        pdata->_commonCacheCharacterName = _metadata.characterName;
+    }
+
+    //!表示中の内容と異なる場合のみUIに反映する
+    if(commonLoaded){
+        if(ui->Info_ComicTitle_LineEdit->text() != _metadata.workTitle){
+            ui->Info_ComicTitle_LineEdit->setText(_metadata.workTitle);
+        }
         resetCharacterList();
     }
 
     //! Page Metadataを開く
     QString pageXMLFileName = QString("%1/").arg(dir.absolutePath());
     pageXMLFileName += QString("%1.xml").arg(imageFileName.baseName());
-    _metadata.loadMetadata_Page(pageXMLFileName);
+    _pdata.data()->_saveQueue.waitFor(pageXMLFileName);
+    if(_pdata.data()->_saveQueue.latestContent(pageXMLFileName, journaled)){
+        QBuffer buffer(&journaled);
+        buffer.open(QIODevice::ReadOnly);
+        _metadata.loadMetadata_Page(&buffer);
+    }
+    else{
+        _metadata.loadMetadata_Page(pageXMLFileName);
+    }
 
     //! 読み込んだページの情報を，UIに反映する
     ui->Info_EpisodeNumber_LineEdit->setText
@@ -3935,28 +4168,28 @@ void MainWindow::loadMetadata()
     for(int i=0; i<_metadata.loadFrame.size(); i++){
         QPolygonF polygon = calcAbsolutePosition(_metadata.loadFrameCoordinate.at(i));
         FrameData data = _metadata.loadFrame.at(i);
-        addFrame(polygon, data.mangaPath, data.sceneBoundary);
+        addFrame(polygon, data.sceneBoundary);
     }
     for(int i=0; i<_metadata.loadCharacter.size(); i++){
         QPolygonF polygon = calcAbsolutePosition(_metadata.loadCharacterCoordinate.at(i));
         CharacterData data = _metadata.loadCharacter.at(i);
-        addCharacter(polygon, data.mangaPath, data.characterName, data.characterID, data.targetFrame);
+        addCharacter(polygon, data.characterName, data.characterID, data.targetFrame);
     }
     for(int i=0; i<_metadata.loadDialog.size(); i++){
         QPolygonF polygon = calcAbsolutePosition(_metadata.loadDialogCoordinate.at(i));
         DialogData data = _metadata.loadDialog.at(i);
-        addDialog(polygon, data.mangaPath,data.text, data.fontSize,
+        addDialog(polygon, data.text, data.fontSize,
                   data.narration, data.targetCharacterID, data.targetFrame, data.characterName);
     }
     for(int i=0; i<_metadata.loadOnomatopoeia.size();i++){
         QPolygonF polygon = calcAbsolutePosition(_metadata.loadOnomatopoeiaCoordinate.at(i));
         OnomatopoeiaData data = _metadata.loadOnomatopoeia.at(i);
-        addOnomatopoeia(polygon, data.mangaPath, data.text, data.fontSize, data.targetFrame);
+        addOnomatopoeia(polygon, data.text, data.fontSize, data.targetFrame);
     }
     for(int i=0; i<_metadata.loadItem.size(); i++){
         QPolygonF polygon = calcAbsolutePosition(_metadata.loadItemCoordinate.at(i));
         ItemData data = _metadata.loadItem.at(i);
-        addItem(polygon, data.mangaPath, data.itemClass, data.description, data.targetFrame);
+        addItem(polygon, data.itemClass, data.description, data.targetFrame);
     }
 }
 
@@ -3995,9 +4228,7 @@ void MainWindow::on_Frame_SceneChange_CheckBox_toggled(bool checked)
     {
         return;
     }
-    FrameData buf = _metadata.frame.data()->at(_currentFrameNumber);
-    buf.sceneBoundary = checked;
-    _metadata.frame.data()->replace(_currentFrameNumber, buf);
+    _metadata.editFrame(_currentFrameNumber).sceneBoundary = checked;
     if(!_isRefreshingNow){
         refresh_Frame_ListWidget(_currentFrameNumber);
     }
@@ -4010,6 +4241,7 @@ void MainWindow::on_Frame_SceneChange_CheckBox_toggled(bool checked)
  */
 void MainWindow::refresh_Frame_ListWidget(int currentIndex)
 {
+    STAGE_TRACE("refresh_Frame_ListWidget");
     _isRefreshingNow = true;
     //!他のウィジェットに最新のフレーム数を反映する
     //Signal->slot方式に変更したいFIXME
@@ -4029,7 +4261,7 @@ void MainWindow::refresh_Frame_ListWidget(int currentIndex)
 
     //! 入力されているフレーム情報を適用する
     for(int i=0; i<_metadata.frame.data()->size(); i++){
-        FrameData f = _metadata.frame.data()->at(i);
+        const FrameData &f = _metadata.frame.data()->at(i);
         QString title = QString("Frame%1 ").arg(i+1,3,10,QChar('0'));
         if(f.sceneBoundary){
             title += " s ";
@@ -4037,7 +4269,7 @@ void MainWindow::refresh_Frame_ListWidget(int currentIndex)
         else{
             title += " - ";
         }
-        QPolygonF polygon = f.GIData.item()->polygon();
+        const QPolygonF &polygon = f.GIData.polygon();
         for(int j=0; j< polygon.size(); j++){
             QPointF pt = polygon.at(j);
             title += QString("(%1,%2) ").arg(pt.x()).arg(pt.y());
@@ -4062,10 +4294,11 @@ void MainWindow::refresh_Frame_ListWidget(int currentIndex)
  */
 void MainWindow::refresh_Character_ListWidget(int currentIndex)
 {
+    STAGE_TRACE("refresh_Character_ListWidget");
     _isRefreshingNow = true;
     ui->ListWidget_Character->clear();
     for(int i=0; i<_metadata.character.data()->size(); i++){
-        CharacterData buf = _metadata.character.data()->at(i);
+        const CharacterData &buf = _metadata.character.data()->at(i);
         QString text = QString("%1:").arg(i,3,10,QChar('0'));
         text += QString(" Frame:%1").arg(buf.targetFrame);
         text += QString(" ID:%1 %2").arg(buf.characterID).arg(buf.characterName);
@@ -4084,10 +4317,11 @@ void MainWindow::refresh_Character_ListWidget(int currentIndex)
  */
 void MainWindow::refresh_Dialog_ListWidget(int currentIndex)
 {
+    STAGE_TRACE("refresh_Dialog_ListWidget");
     _isRefreshingNow = true;
     ui->ListWidget_Dialog->clear();
     for(int i=0; i<_metadata.dialog.data()->size(); i++){
-        DialogData buf = _metadata.dialog.data()->at(i);
+        const DialogData &buf = _metadata.dialog.data()->at(i);
         QString text = QString("Dialog%1:").arg(i,3,10,QChar('0'));
         text += QString(" Frame:%1").arg(buf.targetFrame);
         if(!buf.narration){
@@ -4115,10 +4349,11 @@ void MainWindow::refresh_Dialog_ListWidget(int currentIndex)
  */
 void MainWindow::refresh_Onomatopoeia_ListWidget(int currentIndex)
 {
+    STAGE_TRACE("refresh_Onomatopoeia_ListWidget");
     _isRefreshingNow = true;
     ui->ListWidget_Onomatopoeia->clear();
     for(int i=0; i<_metadata.onomatopoeia.data()->size(); i++){
-        OnomatopoeiaData buf = _metadata.onomatopoeia.data()->at(i);
+        const OnomatopoeiaData &buf = _metadata.onomatopoeia.data()->at(i);
         QString text = QString("%1:").arg(i,3,10,QChar('0'));
         text += QString(" Frame:%1 ").arg(buf.targetFrame);
         //text += getFirstLine(buf.text);
@@ -4138,10 +4373,11 @@ void MainWindow::refresh_Onomatopoeia_ListWidget(int currentIndex)
  */
 void MainWindow::refresh_Item_ListWidget(int currentIndex)
 {
+    STAGE_TRACE("refresh_Item_ListWidget");
     _isRefreshingNow = true;
     ui->ListWidget_CItem->clear();
     for(int i=0; i<_metadata.item.data()->size(); i++){
-        ItemData buf = _metadata.item.data()->at(i);
+        const ItemData &buf = _metadata.item.data()->at(i);
         QString text = QString("%1:").arg(i, 3, 10, QChar('0'));
         text += QString(" Frame:%1").arg(buf.targetFrame);
         text += QString(" %1").arg(cvtSingleLine(buf.itemClass));
@@ -4156,6 +4392,7 @@ void MainWindow::refresh_Item_ListWidget(int currentIndex)
 
 void MainWindow::refresh_ALL_ListWidget()
 {
+    STAGE_TRACE("refresh_ALL_ListWidget");
     refresh_Frame_ListWidget();
     refresh_Character_ListWidget();
     refresh_Dialog_ListWidget();
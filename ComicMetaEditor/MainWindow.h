@@ -19,11 +19,13 @@
 #include <QScopedPointer>
 #include <QGraphicsItem>
 #include <QList>
+#include <QBitArray>
 #include <QRadialGradient>
 #include "FileUtility.h"
 #include "ComicMetaEditorSetting.h"
 #include "CommonFunction.h"
 #include "ComicMetadata.h"
+#include "PolygonGridIndex.h"
 #include <QListWidget>
 #include <QTextDocument>
 
@@ -32,6 +34,8 @@
 //!if IMAGE SIZE CONVERSION == true
 //!loaded image size is converted to fit it's longer side
 //!to TARGET_IMAGE_LENGTH
+//!(the converted image defines the scene coordinates; on zoom-in,
+//! TiledImageItem draws higher resolution tiles from the original file)
 #define IMAGE_SIZE_CONVERSION true;
 #define TARGET_IMAGE_LENGTH 1500;
 
@@ -41,6 +45,7 @@ class MainWindow;
 }
 class MainWindowPrivateData;
 class MainWindowGraphicsViewData;
+class FilmstripWidget;
 
 //!メインウィンドウの各機能用インデックス
 enum MainWindowTabType{
@@ -126,6 +131,20 @@ private slots:
     void Sl_GVKy_release(QKeyEvent* event);
     //!画像のズーム率が変更された際の動作
     void Sl_GV_zoomed(double);
+    //!仮画像表示中のページの本読み込みが完了した際の動作
+    void Sl_fullImageLoaded();
+    //!フィルムストリップでページが選択された際の動作
+    void Sl_filmstripPageSelected(int number);
+    //!ディレクトリ内のファイル一覧が読み直された際の動作
+    void Sl_fileListChanged();
+    //!メタデータの保存に失敗した際の動作
+    void Sl_metadataSaveFailed(QString fileName);
+    //!トレースの有効・無効が切り替えられた際の動作
+    void Sl_traceToggled(bool enabled);
+    //!トレースの保存が選択された際の動作
+    void Sl_saveTrace();
+    //!トレースの消去が選択された際の動作
+    void Sl_clearTrace();
 
 
     void on_functionTab_currentChanged(int index);
@@ -199,10 +218,13 @@ private:
     QSharedPointer<QImage> _image; //!< _imageと_sceneはmain本体で持っておく事とする
     QSharedPointer<QGraphicsScene> _scene; //!< 表示用のGraphicsScene
     IL::FileUtility _fileUtility; //!<　画像ファイル名等のハンドリング用ユーティリティー
+    FilmstripWidget *_filmstrip; //!< ディレクトリ内のページのサムネイル一覧
     ComicMetaEditorSetting _setting; //!<　本アプリケーションの設定格納場所
     ComicMetadata _metadata; //!< メタデータ格納場所
-    bool _commonMetadataEdit; //!< 共通メタデータが編集された場合のフラグ
-    bool _pageMetadataEdit; //!< ページメタデータが編集された場合のフラグ
+    QVector<QString> _shownCharacterName; //!< 登場人物リストのウィジェットに表示中の名前リスト
+    QString _traceFileName; //!< 終了時にトレースを出力するファイル名（環境変数で指定された場合）
+
+    bool writeTrace(QString fileName);
 
     //create polygon and rect
     bool _crossCursor; //!<現在十字型のカーソルになっている場合のフラグ
@@ -263,7 +285,8 @@ private:
     ComicMetadataType _selectTargetType; //!< 選択モードの処理対象ターゲットメタデータタイプ
     void startSelectMode(ComicMetadataType type);
     QVector<GraphicsItemData> _selectTarget;//!< 選択モード関連
-    QVector<double> _selectItemPolygonSizeList;//!< 選択モード関連
+    PolygonGridIndex _polygonIndex[ComicMetadata_All];//!< 選択モード関連 メタデータの種類毎の当たり判定用空間インデックス
+    void clearPolygonIndex();//!< 選択モード関連
     int _selectedItemNumber;//!< 選択モード関連
     bool _selectLock;//!< 選択モード関連
     int selectItem(QPoint pt);//!< 選択モード関連
@@ -286,8 +309,9 @@ private:
     bool _isSetOrderMode;///!<順番設定モード関連
     ComicMetadataType _setOrderTargetType;//!<順番設定モード関連
     QVector<GraphicsItemData> _setOrderTarget;//!<順番設定モード関連
-    QVector<double> _isSetOrderModePolygonSizeList;//!<順番設定モード関連
+    PolygonGridIndex _setOrderIndex;//!<順番設定モード関連 当たり判定用（選択済みのものは検索対象から外す）
     QVector<int> _isSetOrderModeSelectedList;//!<順番設定モード関連
+    QBitArray _isSetOrderModeSelected;//!<順番設定モード関連 インデックス毎の選択済みフラグ
     QVector<QGraphicsRectItem*> _orderNumberRect;//!<順番設定モード関連
     QVector<QGraphicsTextItem*> _orderNumberText;//!<順番設定モード関連
     void setOrderModeCancel();// 順番設定モード関連
@@ -295,8 +319,7 @@ private:
     void setOrderModeMouseRightClick();// 順番設定モード関連
     void setOrderModeTerminate();// 順番設定モード関連
     void setOrderModeMouseMove(QPoint pt);// 順番設定モード関連
-    int selectItem(QVector<GraphicsItemData>& target,
-                   QVector<double> &sizeList, QPoint pt, QVector<int> &ignore);// 順番設定モード関連
+    int selectItem(const PolygonGridIndex &index, QPoint pt);// 順番設定モード関連
 
     bool _isShowOrderMode;//!<順番確認モード関連
     void showOrder(ComicMetadataType type);//!<順番確認モード関連
@@ -308,30 +331,28 @@ private:
     MainWindowTabType _currentTabType;//!< 現在のメインウィンドウの右側タブモードの状態を保持する変数
 
     int _currentFrameNumber; //!< 現在選択されているFrameのインデックス
-    void addFrame(QPolygonF polygon, QString mangaPath = "",
-                  bool sceneBoundery = false);
+    void addFrame(QPolygonF polygon, bool sceneBoundery = false);
     void specifyFrame(int number = -1);
     void clearFrameUI();
 
     int _currentCharacterNumber;//!< 現在選択されているCharacterのインデックス
     void addCharacter
-        (QPolygonF polygon, QString mangaPath = "", QString characterName = "--",
+        (QPolygonF polygon, QString characterName = "--",
          int characterID = 0, int targetFrame = 0);
     void specifyCharacter(int number = -1);
     void clearCharacterUI();
 
     int _currentDialogNumber;//!< 現在選択されているDialogのインデックス
     void addDialog
-        (QPolygonF polygon, QString mangaPath = "", QString text = "", int fontsize = 3,
+        (QPolygonF polygon, QString text = "", int fontsize = 3,
          bool narration = false, int targetCharacterID = 0,
          int targetFrame = 0, QString characterName = "--");
     void specifyDialog(int number = -1);
     void clearDialogUI();
 
     int _currentOnomatopoeiaNumber;//!< 現在選択されているOnomatopoeiaのインデックス
-    OnomatopoeiaData _currentOnomatopoeia;//!< 現在選択されているオノマトペデータ
     void addOnomatopoeia
-    (QPolygonF polygon, QString mangaPath = "", QString text = "",
+    (QPolygonF polygon, QString text = "",
      int fontsize = 3, bool targetFrame = 0);
     void specifyOnomatopoeia(int number = -1);
     void clearOnomatopoeiaUI();
@@ -346,7 +367,7 @@ private:
     int _currentCItemNumber;//!< 現在選択されているItemのインデックス
     ItemData _currentItem;//!< 現在選択されているItemのデータ
     void addItem
-    (QPolygonF polygon, QString mangaPath = "", QString itemClass = "Item",
+    (QPolygonF polygon, QString itemClass = "Item",
      QString description = "", int targetFrame = 0);
     void specifyItem(int number = -1);
     void clearItemUI();
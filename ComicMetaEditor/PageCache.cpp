@@ -0,0 +1,115 @@
+﻿/*! \file
+ *  \brief 表示用ページ画像のキャッシュ 実装部
+ *  \date 2026/10/17 新規作成
+ */
+
+#include "PageCache.h"
+#include <QFileInfo>
+
+//! QCacheのコストはint型のため、KB単位で管理する
+static int toCost(qint64 bytes)
+{
+    return (int)(bytes / 1024) + 1;
+}
+
+PageCache::PageCache(qint64 maxBytes)
+{
+    _hitCount = 0;
+    _missCount = 0;
+    setMaxBytes(maxBytes);
+}
+
+void PageCache::setMaxBytes(qint64 maxBytes)
+{
+    _cache.setMaxCost(toCost(maxBytes));
+}
+
+qint64 PageCache::maxBytes() const
+{
+    return (qint64)_cache.maxCost() * 1024;
+}
+
+qint64 PageCache::totalBytes() const
+{
+    return (qint64)_cache.totalCost() * 1024;
+}
+
+bool PageCache::isEmpty() const
+{
+    return _cache.isEmpty();
+}
+
+QString PageCache::cacheKey(QString absoluteFilePath, QDateTime lastModified) const
+{
+    return absoluteFilePath + "|" + QString::number(lastModified.toMSecsSinceEpoch());
+}
+
+bool PageCache::find(QString fileName, PageImage &page)
+{
+    QFileInfo info(fileName);
+    QString key = cacheKey(info.absoluteFilePath(), info.lastModified());
+    PageImage *cached = _cache.object(key);
+    if(cached == NULL){
+        _missCount++;
+        return false;
+    }
+    _hitCount++;
+    page = *cached;
+    return true;
+}
+
+bool PageCache::contains(QString fileName) const
+{
+    QFileInfo info(fileName);
+    return _cache.contains(cacheKey(info.absoluteFilePath(), info.lastModified()));
+}
+
+void PageCache::insert(const PageImage &page)
+{
+    if(page.isNull()) return;
+
+    //!同じファイルの古い（更新日時が異なる）データは破棄する
+    QString key = cacheKey(page.fileName, page.lastModified);
+    QString oldKey = _keyOfPath.value(page.fileName);
+    if(!oldKey.isEmpty() && oldKey != key){
+        _cache.remove(oldKey);
+    }
+
+    qint64 bytes = (qint64)page.image.bytesPerLine() * page.image.height();
+    if(_cache.insert(key, new PageImage(page), toCost(bytes))){
+        _keyOfPath.insert(page.fileName, key);
+    }
+    else{
+        _keyOfPath.remove(page.fileName);
+    }
+
+    //!キャッシュから既に破棄されたものの対応を整理する
+    if(_keyOfPath.size() > 2 * _cache.size() + 16){
+        QHash<QString, QString>::iterator it = _keyOfPath.begin();
+        while(it != _keyOfPath.end()){
+            if(_cache.contains(it.value())) ++it;
+            else it = _keyOfPath.erase(it);
+        }
+    }
+}
+
+void PageCache::trim(qint64 bytes)
+{
+    int maxCost = _cache.maxCost();
+    _cache.setMaxCost(bytes <= 0 ? 0 : toCost(bytes));
+    _cache.setMaxCost(maxCost);
+}
+
+void PageCache::clear()
+{
+    _cache.clear();
+    _keyOfPath.clear();
+}
+
+QString PageCache::statistics() const
+{
+    return QString("cache %1/%2 MB, hit %3/%4")
+            .arg(totalBytes() / (1024.0 * 1024.0), 0, 'f', 1)
+            .arg(maxBytes() / (1024 * 1024))
+            .arg(_hitCount).arg(_hitCount + _missCount);
+}
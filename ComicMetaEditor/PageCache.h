@@ -0,0 +1,61 @@
+﻿/*! \file
+ *  \brief 表示用ページ画像のキャッシュ
+ *  \date 2026/10/17 新規作成
+ */
+
+#ifndef PAGECACHE_H
+#define PAGECACHE_H
+
+#include "PageImage.h"
+#include <QCache>
+#include <QHash>
+
+/*!
+ * \brief 縮小済みのページ画像を保持するLRUキャッシュ
+ * キーは絶対パスとファイル更新日時の組で、ファイルが更新された場合は古いデータを使用しない。\n
+ * 保持する画像の合計サイズは予算（バイト数）を超えないよう、最も長く使われていないものから破棄する
+ */
+class PageCache
+{
+public:
+    PageCache(qint64 maxBytes = 256 * 1024 * 1024);
+
+    void setMaxBytes(qint64 maxBytes);
+    qint64 maxBytes() const;
+    qint64 totalBytes() const;
+    bool isEmpty() const;
+
+    /*!
+     * \brief キャッシュからページ画像を取得する
+     * \param fileName 画像ファイル名
+     * \param page 取得結果の格納先
+     * \return キャッシュに有効なデータがなかった場合false
+     */
+    bool find(QString fileName, PageImage &page);
+
+    //! 有効なデータがキャッシュにあるかを返す（LRU順は更新しない）
+    bool contains(QString fileName) const;
+
+    //! ページ画像をキャッシュに追加する
+    void insert(const PageImage &page);
+
+    /*!
+     * \brief メモリ不足時に使用する。保持量が指定サイズ以下になるまで古いものから破棄する
+     * \param bytes 破棄後の保持量の上限
+     */
+    void trim(qint64 bytes);
+
+    void clear();
+
+    //! キャッシュの使用状況をステータス表示用の文字列で返す
+    QString statistics() const;
+
+private:
+    QString cacheKey(QString absoluteFilePath, QDateTime lastModified) const;
+    QCache<QString, PageImage> _cache; //!< コストはKB単位
+    QHash<QString, QString> _keyOfPath; //!< 絶対パスから現在のキーへの対応
+    int _hitCount;
+    int _missCount;
+};
+
+#endif // PAGECACHE_H
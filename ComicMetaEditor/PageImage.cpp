@@ -0,0 +1,125 @@
+﻿/*! \file
+ *  \brief 表示用ページ画像の読み込み処理 実装部
+ *  \date 2026/10/17 新規作成
+ */
+
+#include "PageImage.h"
+#include "StageTrace.h"
+#include <QFileInfo>
+#include <QImageReader>
+#include <algorithm>
+
+PageImage::PageImage()
+{
+}
+
+bool PageImage::isNull() const
+{
+    return image.isNull();
+}
+
+double calcImageSizeRatio(QSize originalSize, int targetImageLength)
+{
+    if(targetImageLength <= 0) return 1.0;
+    if(originalSize.isEmpty()) return 0.0;
+    double dx = (double)targetImageLength / originalSize.width();
+    double dy = (double)targetImageLength / originalSize.height();
+    return std::min(dx,dy);
+}
+
+QSize calcDisplayImageSize(QSize originalSize, int targetImageLength)
+{
+    if(targetImageLength <= 0) return originalSize;
+    double sizeRatio = calcImageSizeRatio(originalSize, targetImageLength);
+    int convertedWidth = sizeRatio * originalSize.width();
+    int convertedHeight = sizeRatio * originalSize.height();
+    //QImage::scaled(..., Qt::KeepAspectRatio, ...)と同じサイズにする
+    return originalSize.scaled(convertedWidth, convertedHeight, Qt::KeepAspectRatio);
+}
+
+PageImage loadPageImage(QString fileName, int targetImageLength)
+{
+    STAGE_TRACE("loadPageImage");
+    PageImage page;
+    QFileInfo info(fileName);
+    page.fileName = info.absoluteFilePath();
+    page.lastModified = info.lastModified();
+
+    //!ヘッダから元画像サイズを取得し、表示サイズに直接デコードする
+    //縮小前の画像（高解像度のスキャン画像等）のバッファを確保しないようにするため
+    QImageReader reader(fileName);
+    QSize originalSize = reader.size();
+    if(targetImageLength > 0 && originalSize.isValid()){
+        reader.setScaledSize(calcDisplayImageSize(originalSize, targetImageLength));
+        reader.setQuality(100);
+        STAGE_TRACE("QImageReader::read");
+        if(reader.read(&page.image)){
+            page.originalSize = originalSize;
+            return page;
+        }
+    }
+
+    //!ヘッダからサイズが取得できない形式の場合や縮小デコードに失敗した場合は、
+    //元画像を読み込んでから変換する
+    QImage original;
+    {
+        STAGE_TRACE("QImage::load");
+        if(!original.load(fileName)) return page;
+    }
+    page.originalSize = original.size();
+
+    //!画像サイズ変換が有効であった場合、一定サイズまで画像サイズを変更する
+    //読み込んだ画像が大きすぎて表示に時間がかかる場合に対応したもの
+    if(targetImageLength > 0){
+        double sizeRatio = calcImageSizeRatio(page.originalSize, targetImageLength);
+        int convertedWidth = sizeRatio * original.width();
+        int convertedHeight = sizeRatio * original.height();
+        STAGE_TRACE("QImage::scaled");
+        page.image = original.scaled
+                (convertedWidth, convertedHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+    else{
+        page.image = original;
+    }
+    return page;
+}
+
+qint64 estimatePageImageBytes(QString fileName, int targetImageLength)
+{
+    QImageReader reader(fileName);
+    QSize originalSize = reader.size();
+    if(!originalSize.isValid()) return 0;
+    QSize displaySize = calcDisplayImageSize(originalSize, targetImageLength);
+    qint64 bytes = (qint64)displaySize.width() * displaySize.height() * 4;
+    if(!reader.supportsOption(QImageIOHandler::ScaledSize)){
+        bytes += (qint64)originalSize.width() * originalSize.height() * 4;
+    }
+    return bytes;
+}
+
+PageImage loadPreviewImage(QString fileName, int targetImageLength)
+{
+    STAGE_TRACE("loadPreviewImage");
+    PageImage page;
+    QFileInfo info(fileName);
+    QImageReader reader(fileName);
+    QSize originalSize = reader.size();
+    if(!originalSize.isValid()) return page;
+    page.fileName = info.absoluteFilePath();
+    page.lastModified = info.lastModified();
+    page.originalSize = originalSize;
+
+    QSize displaySize = calcDisplayImageSize(originalSize, targetImageLength);
+    if(reader.supportsOption(QImageIOHandler::ScaledSize)){
+        //!1/4サイズでデコードし、表示サイズまで拡大する
+        QImage preview;
+        reader.setScaledSize(displaySize / 4);
+        if(reader.read(&preview)){
+            page.image = preview.scaled(displaySize, Qt::IgnoreAspectRatio, Qt::FastTransformation);
+            return page;
+        }
+    }
+    page.image = QImage(displaySize, QImage::Format_RGB32);
+    page.image.fill(Qt::lightGray);
+    return page;
+}
@@ -0,0 +1,73 @@
+﻿/*! \file
+ *  \brief 表示用ページ画像の読み込み処理
+ *  \date 2026/10/17 新規作成
+ */
+
+#ifndef PAGEIMAGE_H
+#define PAGEIMAGE_H
+
+#include <QString>
+#include <QImage>
+#include <QSize>
+#include <QDateTime>
+
+/*!
+ * \brief 表示用に縮小済みのページ画像と、元画像のサイズの組
+ * ワーカースレッドで生成し、GUIスレッドへ受け渡すことを想定している（QPixmapは使用しない）
+ */
+class PageImage{
+public:
+    PageImage();
+    QString fileName; //!< 読み込んだ画像ファイル名（絶対パス）
+    QDateTime lastModified; //!< 読み込み時点でのファイル更新日時
+    QImage image; //!< 表示に使用する画像
+    QSize originalSize; //!< 元画像のサイズ（メタデータのImageSizeに使用する）
+    bool isNull() const;
+};
+
+/*!
+ * \brief 元画像との画像サイズ比を計算する
+ * \param originalSize 元画像のサイズ
+ * \param targetImageLength 縮小ターゲットサイズ（0以下の場合は変換しない）
+ * \return 元画像を1.0としたときの、表示に使用するターゲット画像のサイズ比
+ */
+double calcImageSizeRatio(QSize originalSize, int targetImageLength);
+
+/*!
+ * \brief 表示用画像のサイズを計算する
+ * \param originalSize 元画像のサイズ
+ * \param targetImageLength 縮小ターゲットサイズ（0以下の場合は変換しない）
+ * \return 表示用画像のサイズ
+ */
+QSize calcDisplayImageSize(QSize originalSize, int targetImageLength);
+
+/*!
+ * \brief 画像を読み込み、表示用のサイズに変換する
+ * スレッドセーフであり、ワーカースレッドから呼び出してよい
+ * \param fileName 画像ファイル名
+ * \param targetImageLength 縮小ターゲットサイズ（0以下の場合は変換しない）
+ * \return 読み込み結果（失敗時はisNull()がtrue）
+ */
+PageImage loadPageImage(QString fileName, int targetImageLength);
+
+/*!
+ * \brief loadPageImageで画像を読み込む際に必要となるメモリ量を、ヘッダの情報から見積もる
+ * 縮小デコードに対応していない形式では、縮小前の画像のバッファも含める
+ * \param fileName 画像ファイル名
+ * \param targetImageLength 縮小ターゲットサイズ（0以下の場合は変換しない）
+ * \return 必要なバイト数（ヘッダから画像サイズが取得できない場合は0）
+ */
+qint64 estimatePageImageBytes(QString fileName, int targetImageLength);
+
+/*!
+ * \brief 本読み込みが終わるまで表示しておく仮画像を作成する
+ * 縮小デコードに対応した形式（JPEG等）では低解像度でデコードしたものを拡大して使用し、
+ * 対応していない形式では無地の画像とする。\n
+ * 画像サイズはloadPageImageで得られる表示用画像と同じであるため、座標系はそのまま使用できる
+ * \param fileName 画像ファイル名
+ * \param targetImageLength 縮小ターゲットサイズ（0以下の場合は変換しない）
+ * \return 仮画像（ヘッダからサイズが取得できない場合はisNull()がtrue）
+ */
+PageImage loadPreviewImage(QString fileName, int targetImageLength);
+
+#endif // PAGEIMAGE_H
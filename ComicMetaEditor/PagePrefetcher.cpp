@@ -0,0 +1,123 @@
+﻿/*! \file
+ *  \brief 前後ページ画像の先読み処理 実装部
+ *  \date 2026/10/17 新規作成
+ */
+
+#include "PagePrefetcher.h"
+#include <QFileInfo>
+#include <QtConcurrentRun>
+
+/*!
+ * \brief 先読みのワーカー処理
+ * 待ち行列にある間に不要になった場合は、読み込まずに空の結果を返す
+ */
+static PageImage loadPrefetchImage(QSharedPointer<QAtomicInt> cancelled,
+                                   QString fileName, int targetImageLength)
+{
+    if(cancelled->load()) return PageImage();
+    return loadPageImage(fileName, targetImageLength);
+}
+
+PagePrefetcher::PagePrefetcher()
+{
+    _pool.setMaxThreadCount(2);
+    _targetImageLength = 0;
+    _hitCount = 0;
+    _lateCount = 0;
+    _missCount = 0;
+}
+
+PagePrefetcher::~PagePrefetcher()
+{
+    clear();
+    _pool.waitForDone();
+}
+
+void PagePrefetcher::setTargetImageLength(int targetImageLength)
+{
+    if(_targetImageLength == targetImageLength) return;
+    _targetImageLength = targetImageLength;
+    clear();
+}
+
+void PagePrefetcher::prefetch(QStringList fileNames)
+{
+    QStringList keys;
+    for(int i=0; i<fileNames.size(); i++){
+        if(fileNames.at(i).isEmpty()) continue;
+        keys.push_back(QFileInfo(fileNames.at(i)).absoluteFilePath());
+    }
+
+    //!不要になった先読みを取り消す
+    //待ち行列にあるものは読み込まずに終了し、実行中のものは完了後に破棄される
+    QHash<QString, Job>::iterator it = _jobs.begin();
+    while(it != _jobs.end()){
+        if(keys.contains(it.key())){
+            ++it;
+        }
+        else{
+            cancel(it.value());
+            it = _jobs.erase(it);
+        }
+    }
+
+    for(int i=0; i<keys.size(); i++){
+        if(_jobs.contains(keys.at(i))) continue;
+        Job job;
+        job.cancelled = QSharedPointer<QAtomicInt>(new QAtomicInt(0));
+        job.future = QtConcurrent::run(&_pool, loadPrefetchImage,
+                                       job.cancelled, keys.at(i), _targetImageLength);
+        _jobs.insert(keys.at(i), job);
+    }
+}
+
+void PagePrefetcher::cancel(Job &job)
+{
+    job.cancelled->store(1);
+}
+
+bool PagePrefetcher::take(QString fileName, QFuture<PageImage> &future)
+{
+    QString key = QFileInfo(fileName).absoluteFilePath();
+    if(!_jobs.contains(key)){
+        _missCount++;
+        return false;
+    }
+    future = _jobs.take(key).future;
+    if(future.isFinished()) _hitCount++;
+    else _lateCount++;
+    return true;
+}
+
+void PagePrefetcher::clear()
+{
+    QHash<QString, Job>::iterator it = _jobs.begin();
+    for(; it != _jobs.end(); ++it){
+        cancel(it.value());
+    }
+    _jobs.clear();
+}
+
+int PagePrefetcher::hitCount() const
+{
+    return _hitCount;
+}
+
+int PagePrefetcher::lateCount() const
+{
+    return _lateCount;
+}
+
+int PagePrefetcher::missCount() const
+{
+    return _missCount;
+}
+
+QString PagePrefetcher::statistics() const
+{
+    int total = _hitCount + _lateCount + _missCount;
+    double ratio = 0.0;
+    if(total > 0) ratio = 100.0 * _hitCount / total;
+    return QString("prefetch hit %1/%2 (%3%), late %4, miss %5")
+            .arg(_hitCount).arg(total).arg(ratio, 0, 'f', 1).arg(_lateCount).arg(_missCount);
+}
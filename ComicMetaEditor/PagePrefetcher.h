@@ -0,0 +1,72 @@
+﻿/*! \file
+ *  \brief 前後ページ画像の先読み処理
+ *  \date 2026/10/17 新規作成
+ */
+
+#ifndef PAGEPREFETCHER_H
+#define PAGEPREFETCHER_H
+
+#include "PageImage.h"
+#include <QHash>
+#include <QFuture>
+#include <QStringList>
+#include <QThreadPool>
+#include <QSharedPointer>
+#include <QAtomicInt>
+
+/*!
+ * \brief ワーカースレッドで前後のページ画像を読み込み・縮小しておくためのクラス
+ * ページ切り替え時にはtake()で準備済みの画像を受け取る。\n
+ * 先読みが間に合ったか（hit）、読み込み中であったか（late）、
+ * 先読みしていなかったか（miss）の回数を記録する
+ */
+class PagePrefetcher
+{
+public:
+    PagePrefetcher();
+    ~PagePrefetcher();
+
+    void setTargetImageLength(int targetImageLength);
+
+    /*!
+     * \brief 指定されたファイル群を先読みする
+     * 指定されなかったファイルの先読み結果は破棄する
+     * \param fileNames 先読みするファイル名
+     */
+    void prefetch(QStringList fileNames);
+
+    /*!
+     * \brief 先読み処理を受け取る
+     * 読み込み中のものも返すため、完了を待つかどうかは呼び出し側で判断する
+     * \param fileName 画像ファイル名
+     * \param future 先読み処理の格納先
+     * \return 先読みされていなかった場合false
+     */
+    bool take(QString fileName, QFuture<PageImage> &future);
+
+    //! 先読み結果を全て破棄する
+    void clear();
+
+    int hitCount() const;
+    int lateCount() const;
+    int missCount() const;
+    //! 先読みの成功率をステータス表示用の文字列で返す
+    QString statistics() const;
+
+private:
+    //! 先読み処理と、不要になった際に未着手の読み込みを取り消すためのフラグの組
+    struct Job{
+        QFuture<PageImage> future;
+        QSharedPointer<QAtomicInt> cancelled;
+    };
+    void cancel(Job &job);
+
+    QThreadPool _pool; //!< 先読み専用のスレッドプール
+    QHash<QString, Job> _jobs; //!< 絶対パスをキーとした先読み処理
+    int _targetImageLength;
+    int _hitCount; //!< 先読みが完了していた回数
+    int _lateCount; //!< 先読みが間に合わなかった回数
+    int _missCount; //!< 先読みされていなかった回数
+};
+
+#endif // PAGEPREFETCHER_H
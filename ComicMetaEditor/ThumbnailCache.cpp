@@ -0,0 +1,102 @@
+﻿/*! \file
+ *  \brief ページ画像のサムネイルのディスクキャッシュ 実装部
+ *  \date 2026/10/17 新規作成
+ */
+
+#include "ThumbnailCache.h"
+#include "PageImage.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QCryptographicHash>
+#include <QStandardPaths>
+#include <QImageReader>
+#include <QDateTime>
+
+ThumbnailCache::ThumbnailCache(QString cacheDirectory, int thumbnailLength,
+                               qint64 maxCacheBytes, int maxCacheDays)
+{
+    if(cacheDirectory.isEmpty()){
+        cacheDirectory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+                + "/thumbnails";
+    }
+    _cacheDirectory = cacheDirectory;
+    _thumbnailLength = thumbnailLength;
+    _maxCacheBytes = maxCacheBytes;
+    _maxCacheDays = maxCacheDays;
+    QDir().mkpath(_cacheDirectory);
+}
+
+int ThumbnailCache::thumbnailLength() const
+{
+    return _thumbnailLength;
+}
+
+QString ThumbnailCache::cacheDirectory() const
+{
+    return _cacheDirectory;
+}
+
+QString ThumbnailCache::cacheFileName(QString fileName) const
+{
+    QFileInfo info(fileName);
+    QString key = QString("%1|%2|%3|%4")
+            .arg(info.absoluteFilePath())
+            .arg(info.lastModified().toMSecsSinceEpoch())
+            .arg(info.size())
+            .arg(_thumbnailLength);
+    QByteArray hash = QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1);
+    return _cacheDirectory + "/" + QString::fromLatin1(hash.toHex()) + ".png";
+}
+
+QImage ThumbnailCache::thumbnail(QString fileName) const
+{
+    QString cacheFile = cacheFileName(fileName);
+    QImage image;
+    if(QFileInfo(cacheFile).exists() && image.load(cacheFile, "PNG")){
+        return image;
+    }
+
+    image = decodeThumbnail(fileName);
+    if(image.isNull()) return image;
+
+    //!書き込み途中のファイルが読まれないよう、一時ファイルに書き込んでから置き換える
+    QSaveFile file(cacheFile);
+    if(file.open(QIODevice::WriteOnly)){
+        if(image.save(&file, "PNG")) file.commit();
+        else file.cancelWriting();
+    }
+    return image;
+}
+
+void ThumbnailCache::trim() const
+{
+    QDir dir(_cacheDirectory);
+    //!新しい順に並べ、期限切れのものと容量を超えた分を削除する
+    QFileInfoList files = dir.entryInfoList(QStringList("*.png"), QDir::Files, QDir::Time);
+    QDateTime expiry = QDateTime::currentDateTime().addDays(-_maxCacheDays);
+    qint64 totalBytes = 0;
+    for(int i=0; i<files.size(); i++){
+        const QFileInfo &info = files.at(i);
+        totalBytes += info.size();
+        if(info.lastModified() < expiry || totalBytes > _maxCacheBytes){
+            QFile::remove(info.absoluteFilePath());
+        }
+    }
+}
+
+QImage ThumbnailCache::decodeThumbnail(QString fileName) const
+{
+    //!形式によらずQImageReaderに縮小サイズを指定してデコードする
+    //縮小デコードに対応した形式（JPEG等）では元画像サイズのバッファを確保せずに済む
+    QImageReader reader(fileName);
+    QSize originalSize = reader.size();
+    if(originalSize.isValid()){
+        QImage image;
+        reader.setScaledSize(calcDisplayImageSize(originalSize, _thumbnailLength));
+        if(reader.read(&image)) return image;
+    }
+
+    //!ヘッダからサイズが取得できない場合や縮小デコードに失敗した場合は通常の読み込みを行う
+    return loadPageImage(fileName, _thumbnailLength).image;
+}
@@ -0,0 +1,60 @@
+﻿/*! \file
+ *  \brief ページ画像のサムネイルのディスクキャッシュ
+ *  \date 2026/10/17 新規作成
+ */
+
+#ifndef THUMBNAILCACHE_H
+#define THUMBNAILCACHE_H
+
+#include <QString>
+#include <QImage>
+
+/*!
+ * \brief サムネイル画像をディスク上にキャッシュするクラス
+ * キャッシュファイル名は画像の絶対パス・更新日時・ファイルサイズから生成するため、
+ * 画像が更新された場合は自動的に作り直される。\n
+ * キャッシュ全体の容量と各ファイルの保存期間には上限があり、trim()で超過分を削除する。\n
+ * thumbnail()とtrim()はスレッドセーフであり、スレッドプールから呼び出してよい
+ */
+class ThumbnailCache
+{
+public:
+    /*!
+     * \brief コンストラクタ
+     * \param cacheDirectory キャッシュの格納ディレクトリ（空の場合はOS標準のキャッシュ領域）
+     * \param thumbnailLength サムネイルの長辺のピクセル数
+     * \param maxCacheBytes キャッシュ全体の容量の上限（バイト）
+     * \param maxCacheDays キャッシュファイルの保存期間の上限（日）
+     */
+    ThumbnailCache(QString cacheDirectory = "", int thumbnailLength = 128,
+                   qint64 maxCacheBytes = 64 * 1024 * 1024, int maxCacheDays = 30);
+
+    int thumbnailLength() const;
+    QString cacheDirectory() const;
+
+    //! 画像ファイルに対応するキャッシュファイル名を返す
+    QString cacheFileName(QString fileName) const;
+
+    /*!
+     * \brief サムネイルを取得する
+     * キャッシュがあればそれを読み込み、なければ画像から生成してキャッシュに保存する
+     * \param fileName 画像ファイル名
+     * \return サムネイル（読み込めない画像の場合はNULL画像）
+     */
+    QImage thumbnail(QString fileName) const;
+
+    /*!
+     * \brief 保存期間を過ぎたキャッシュファイルを削除し、容量の上限を超えていれば古いものから削除する
+     */
+    void trim() const;
+
+private:
+    QImage decodeThumbnail(QString fileName) const;
+
+    QString _cacheDirectory; //!< キャッシュの格納ディレクトリ
+    int _thumbnailLength; //!< サムネイルの長辺のピクセル数
+    qint64 _maxCacheBytes; //!< キャッシュ全体の容量の上限（バイト）
+    int _maxCacheDays; //!< キャッシュファイルの保存期間の上限（日）
+};
+
+#endif // THUMBNAILCACHE_H
@@ -0,0 +1,217 @@
+﻿/*! \file
+ *  \brief 拡大率に応じて解像度を切り替えるタイル分割画像表示アイテム 実装部
+ *  \date 2026/10/17 新規作成
+ */
+
+#include "TiledImageItem.h"
+#include "StageTrace.h"
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <QImageReader>
+#include <QtConcurrentRun>
+#include <cmath>
+
+//! 部分デコードに対応していない形式で、レベル全体を一括で読み込む場合のタイル番号
+static const quint64 WHOLE_LEVEL = 0xFFFFFF;
+
+static quint64 tileKey(int level, quint64 tx, quint64 ty)
+{
+    return ((quint64)level << 48) | (ty << 24) | tx;
+}
+
+//! QCacheのコストはKB単位で管理する
+static int pixmapCost(const QPixmap &pixmap)
+{
+    return (int)((qint64)pixmap.width() * pixmap.height() * 4 / 1024) + 1;
+}
+
+/*!
+ * \brief 元画像の指定範囲を指定サイズでデコードする（ワーカースレッドで実行される）
+ * \param fileName 画像ファイル名
+ * \param clipRect 元画像上の範囲（無効な矩形の場合は画像全体）
+ * \param scaledSize デコード後のサイズ
+ * \return デコード結果
+ */
+static QImage decodeRegion(QString fileName, QRect clipRect, QSize scaledSize)
+{
+    QImageReader reader(fileName);
+    if(clipRect.isValid()) reader.setClipRect(clipRect);
+    reader.setScaledSize(scaledSize);
+    reader.setQuality(100);
+    QImage image;
+    reader.read(&image);
+    return image;
+}
+
+TiledImageItem::TiledImageItem(QString fileName, QImage baseImage, QSize originalSize,
+                               QGraphicsItem *parent) :
+    QGraphicsObject(parent)
+{
+    _fileName = fileName;
+    {
+        STAGE_TRACE("QPixmap::fromImage");
+        _basePixmap = QPixmap::fromImage(baseImage);
+    }
+    _displaySize = baseImage.size();
+    _originalSize = originalSize;
+    _tileSize = 512;
+    _clipDecode = QImageReader(fileName).supportsOption(QImageIOHandler::ClipRect);
+    setTileCacheSize(128 * 1024 * 1024);
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true);
+}
+
+TiledImageItem::~TiledImageItem()
+{
+}
+
+QRectF TiledImageItem::boundingRect() const
+{
+    return QRectF(QPointF(0,0), _displaySize);
+}
+
+void TiledImageItem::setBaseImage(QImage baseImage)
+{
+    STAGE_TRACE("QPixmap::fromImage");
+    _basePixmap = QPixmap::fromImage(baseImage);
+    update();
+}
+
+void TiledImageItem::setTileCacheSize(qint64 bytes)
+{
+    _tiles.setMaxCost((int)(bytes / 1024));
+}
+
+QSize TiledImageItem::levelSize(int level) const
+{
+    int n = 1 << level;
+    return QSize((_originalSize.width() + n - 1) / n, (_originalSize.height() + n - 1) / n);
+}
+
+double TiledImageItem::levelToItemRatio(int level) const
+{
+    return (double)_displaySize.width() / levelSize(level).width();
+}
+
+/*!
+ * \brief 表示倍率に対して必要十分な解像度のレベルを選択する
+ * \param scale アイテム座標1単位あたりの画面上のピクセル数
+ * \return レベル（ベース画像で十分な場合は-1）
+ */
+int TiledImageItem::levelForScale(double scale) const
+{
+    if(scale <= 1.0 || _displaySize.isEmpty() || _originalSize.isEmpty()) return -1;
+    int level = 0;
+    while(levelSize(level + 1).width() >= scale * _displaySize.width()
+          && levelSize(level + 1).width() > 1){
+        level++;
+    }
+    //!部分デコードできない形式では、レベル全体がタイルキャッシュに収まる解像度までに制限する
+    if(!_clipDecode){
+        while((qint64)levelSize(level).width() * levelSize(level).height() * 4 / 1024
+              > _tiles.maxCost()){
+            level++;
+        }
+    }
+    if(levelSize(level).width() <= _displaySize.width()) return -1;
+    return level;
+}
+
+QRect TiledImageItem::tileRect(int level, int tx, int ty) const
+{
+    QRect rect(tx * _tileSize, ty * _tileSize, _tileSize, _tileSize);
+    return rect.intersected(QRect(QPoint(0,0), levelSize(level)));
+}
+
+void TiledImageItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    Q_UNUSED(widget);
+    painter->drawPixmap(QPointF(0,0), _basePixmap);
+
+    double lod = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    int level = levelForScale(lod);
+    if(level < 0) return;
+
+    //!表示範囲に含まれるタイルのみを描画・要求する
+    double ratio = levelToItemRatio(level);
+    QRectF exposed = option->exposedRect.intersected(boundingRect());
+    if(exposed.isEmpty()) return;
+    int tx0 = std::floor(exposed.left() / ratio) / _tileSize;
+    int ty0 = std::floor(exposed.top() / ratio) / _tileSize;
+    int tx1 = (std::ceil(exposed.right() / ratio) - 1) / _tileSize;
+    int ty1 = (std::ceil(exposed.bottom() / ratio) - 1) / _tileSize;
+    for(int ty=ty0; ty<=ty1; ty++){
+        for(int tx=tx0; tx<=tx1; tx++){
+            QRect rect = tileRect(level, tx, ty);
+            if(rect.isEmpty()) continue;
+            QPixmap *tile = _tiles.object(tileKey(level, tx, ty));
+            if(tile == NULL){
+                requestTile(level, tx, ty);
+                continue;
+            }
+            QRectF target(rect.x() * ratio, rect.y() * ratio,
+                          rect.width() * ratio, rect.height() * ratio);
+            painter->drawPixmap(target, *tile, QRectF(tile->rect()));
+        }
+    }
+}
+
+void TiledImageItem::requestTile(int level, int tx, int ty)
+{
+    quint64 key;
+    QRect clipRect;
+    QSize scaledSize;
+    if(_clipDecode){
+        key = tileKey(level, tx, ty);
+        QRect rect = tileRect(level, tx, ty);
+        int n = 1 << level;
+        clipRect = QRect(rect.x() * n, rect.y() * n, rect.width() * n, rect.height() * n)
+                .intersected(QRect(QPoint(0,0), _originalSize));
+        scaledSize = rect.size();
+    }
+    else{
+        key = tileKey(level, WHOLE_LEVEL, WHOLE_LEVEL);
+        scaledSize = levelSize(level);
+    }
+
+    QHash<QFutureWatcher<QImage>*, quint64>::const_iterator it;
+    for(it = _pending.constBegin(); it != _pending.constEnd(); ++it){
+        if(it.value() == key) return;
+    }
+
+    QFutureWatcher<QImage> *watcher = new QFutureWatcher<QImage>(this);
+    connect(watcher, SIGNAL(finished()), this, SLOT(Sl_tileLoaded()));
+    _pending.insert(watcher, key);
+    watcher->setFuture(QtConcurrent::run(decodeRegion, _fileName, clipRect, scaledSize));
+}
+
+void TiledImageItem::Sl_tileLoaded()
+{
+    QFutureWatcher<QImage> *watcher = static_cast<QFutureWatcher<QImage>*>(sender());
+    if(!_pending.contains(watcher)) return;
+    quint64 key = _pending.take(watcher);
+    QImage image = watcher->result();
+    watcher->deleteLater();
+    if(image.isNull()) return;
+
+    int level = (int)(key >> 48);
+    if((key & WHOLE_LEVEL) != WHOLE_LEVEL){
+        storeTile(key, image);
+        update();
+        return;
+    }
+
+    //!レベル全体を読み込んだ場合はタイルに分割して格納する
+    for(int ty=0; ty * _tileSize < image.height(); ty++){
+        for(int tx=0; tx * _tileSize < image.width(); tx++){
+            storeTile(tileKey(level, tx, ty), image.copy(tileRect(level, tx, ty)));
+        }
+    }
+    update();
+}
+
+void TiledImageItem::storeTile(quint64 key, const QImage &image)
+{
+    STAGE_TRACE("QPixmap::fromImage");
+    QPixmap *tile = new QPixmap(QPixmap::fromImage(image));
+    _tiles.insert(key, tile, pixmapCost(*tile));
+}
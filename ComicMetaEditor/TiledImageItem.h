@@ -0,0 +1,62 @@
+﻿/*! \file
+ *  \brief 拡大率に応じて解像度を切り替えるタイル分割画像表示アイテム
+ *  \date 2026/10/17 新規作成
+ */
+
+#ifndef TILEDIMAGEITEM_H
+#define TILEDIMAGEITEM_H
+
+#include <QGraphicsObject>
+#include <QCache>
+#include <QHash>
+#include <QPixmap>
+#include <QImage>
+#include <QFutureWatcher>
+
+/*!
+ * \brief ページ画像を画像ピラミッド（ミップマップ）＋タイル分割で表示するグラフィックスアイテム
+ * アイテム座標系は縮小済みの表示用画像（ベース画像）のピクセル座標であり、
+ * メタデータのポリゴン等は従来通りこの座標系で扱う。\n
+ * ベース画像の解像度を超えて拡大表示された場合のみ、表示範囲に含まれるタイルを
+ * 必要な解像度（元画像の1/2^levelサイズ）でバックグラウンドで読み込み、ベース画像の上に描画する。\n
+ * 読み込んだタイルはバイト数の上限付きでキャッシュする
+ */
+class TiledImageItem : public QGraphicsObject
+{
+    Q_OBJECT
+public:
+    TiledImageItem(QString fileName, QImage baseImage, QSize originalSize,
+                   QGraphicsItem *parent = 0);
+    ~TiledImageItem();
+
+    QRectF boundingRect() const;
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget);
+
+    //! ベース画像を差し替える（サイズは同一であること）
+    void setBaseImage(QImage baseImage);
+
+    //! タイルキャッシュの上限（バイト数）をセットする
+    void setTileCacheSize(qint64 bytes);
+
+private slots:
+    void Sl_tileLoaded();
+
+private:
+    QString _fileName; //!< 元画像ファイル名
+    QPixmap _basePixmap; //!< 表示用に縮小済みのベース画像
+    QSize _displaySize; //!< ベース画像のサイズ（アイテム座標系の大きさ）
+    QSize _originalSize; //!< 元画像のサイズ
+    int _tileSize; //!< タイル1辺のピクセル数
+    bool _clipDecode; //!< 画像形式が部分デコード（ClipRect）に対応しているか
+    QCache<quint64, QPixmap> _tiles; //!< 読み込み済みタイル（コストはKB単位）
+    QHash<QFutureWatcher<QImage>*, quint64> _pending; //!< 読み込み中のタイル
+
+    int levelForScale(double scale) const;
+    QSize levelSize(int level) const;
+    double levelToItemRatio(int level) const;
+    QRect tileRect(int level, int tx, int ty) const;
+    void requestTile(int level, int tx, int ty);
+    void storeTile(quint64 key, const QImage &image);
+};
+
+#endif // TILEDIMAGEITEM_H
@@ -0,0 +1,19 @@
+#-------------------------------------------------
+#
+# ComicMetaEditorCoreライブラリを使用するプロジェクト用の設定
+# 使用する側の.proにて include(../ComicMetaEditorCore/ComicMetaEditorCore.pri) とする
+#
+#-------------------------------------------------
+
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+win32:CONFIG(release, debug|release): CORE_LIB_DIR = $$OUT_PWD/../ComicMetaEditorCore/release
+else:win32:CONFIG(debug, debug|release): CORE_LIB_DIR = $$OUT_PWD/../ComicMetaEditorCore/debug
+else: CORE_LIB_DIR = $$OUT_PWD/../ComicMetaEditorCore
+
+LIBS += -L$$CORE_LIB_DIR -lComicMetaEditorCore
+
+win32-g++: PRE_TARGETDEPS += $$CORE_LIB_DIR/libComicMetaEditorCore.a
+else:win32: PRE_TARGETDEPS += $$CORE_LIB_DIR/ComicMetaEditorCore.lib
+else: PRE_TARGETDEPS += $$CORE_LIB_DIR/libComicMetaEditorCore.a
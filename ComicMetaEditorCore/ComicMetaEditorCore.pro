@@ -0,0 +1,37 @@
+#-------------------------------------------------
+#
+# メタデータの読み書き・座標計算等、GUIに依存しない処理のライブラリ
+# （ComicMetaEditor本体とコマンドラインツールで共用する）
+#
+#-------------------------------------------------
+
+QT       = core gui
+
+TARGET = ComicMetaEditorCore
+TEMPLATE = lib
+CONFIG += staticlib c++11
+
+SOURCES +=\
+    FileUtility.cpp \
+    CommonFunction.cpp \
+    GraphicsItemData.cpp \
+    ComicMetadata.cpp \
+    MetadataSaveQueue.cpp \
+    MetadataJournal.cpp \
+    SyntheticMetadata.cpp \
+    StageTrace.cpp \
+    PolygonGridIndex.cpp \
+    StableIdIndex.cpp
+
+HEADERS  += \
+    Common.h \
+    FileUtility.h\
+    CommonFunction.h \
+    GraphicsItemData.h \
+    ComicMetadata.h \
+    MetadataSaveQueue.h \
+    MetadataJournal.h \
+    SyntheticMetadata.h \
+    StageTrace.h \
+    PolygonGridIndex.h \
+    StableIdIndex.h
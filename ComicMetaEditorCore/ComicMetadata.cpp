@@ -0,0 +1,1301 @@
+﻿/*!
+ * \file
+ */
+
+#include "ComicMetadata.h"
+#include <QSaveFile>
+#include <iostream>
+QString UnDefinedCharacterName = "Undefined Character";
+
+
+using namespace std;
+FrameData::FrameData(){
+    GIData.setColorPreset(GraphicsItemDataColor_Blue);
+    this->sceneBoundary = false;
+}
+
+CharacterData::CharacterData()
+{
+    GIData.setColorPreset(GraphicsItemDataColor_Red);
+    characterName = "--";
+    characterID = 0;
+    targetFrame = 0;
+}
+
+DialogData::DialogData()
+{
+    text = "";
+    narration = false;
+    fontSize = 3;
+    targetCharacterID = 0;
+    targetFrame = 0;
+    GIData.setColorPreset(GraphicsItemDataColor_Green);
+    characterName = "--";
+}
+
+OnomatopoeiaData::OnomatopoeiaData()
+{
+    GIData.setColorPreset(GraphicsItemDataColor_Purple);
+    text = "";
+    fontSize = 3;
+    targetFrame = 0;
+}
+
+ItemData::ItemData()
+{
+    GIData.setColorPreset(GraphicsItemDataColor_LightBlue);
+    description = "";
+    itemClass = "Item";
+    targetFrame = 0;
+}
+
+ComicMetadata::ComicMetadata()
+{
+    frame = QSharedPointer<QVector<FrameData> >(new QVector<FrameData>);
+    character = QSharedPointer<QVector<CharacterData> >(new QVector<CharacterData>);
+    dialog = QSharedPointer<QVector<DialogData> >(new QVector<DialogData>);
+    onomatopoeia = QSharedPointer<QVector<OnomatopoeiaData> >(new QVector<OnomatopoeiaData>);
+    item = QSharedPointer<QVector<ItemData> >(new QVector<ItemData>);
+    clear();
+    indent = 4;
+    _changed = ComicMetadataChange_None;
+}
+
+QSharedPointer<ComicMetadata> ComicMetadata::clone() const
+{
+    QSharedPointer<ComicMetadata> copy(new ComicMetadata(*this));
+
+    //!リストは共有ポインタで保持しているため、中身を新しいリストに複製する
+    copy.data()->frame = QSharedPointer<QVector<FrameData> >(new QVector<FrameData>(*frame.data()));
+    copy.data()->character = QSharedPointer<QVector<CharacterData> >(new QVector<CharacterData>(*character.data()));
+    copy.data()->dialog = QSharedPointer<QVector<DialogData> >(new QVector<DialogData>(*dialog.data()));
+    copy.data()->onomatopoeia = QSharedPointer<QVector<OnomatopoeiaData> >(new QVector<OnomatopoeiaData>(*onomatopoeia.data()));
+    copy.data()->item = QSharedPointer<QVector<ItemData> >(new QVector<ItemData>(*item.data()));
+
+    //!表示用アイテムはUIスレッドの持ち物のため、複製からは参照させない
+    for(int i=0; i<copy.data()->frame.data()->size(); i++) (*copy.data()->frame.data())[i].GIData._item = NULL;
+    for(int i=0; i<copy.data()->character.data()->size(); i++) (*copy.data()->character.data())[i].GIData._item = NULL;
+    for(int i=0; i<copy.data()->dialog.data()->size(); i++) (*copy.data()->dialog.data())[i].GIData._item = NULL;
+    for(int i=0; i<copy.data()->onomatopoeia.data()->size(); i++) (*copy.data()->onomatopoeia.data())[i].GIData._item = NULL;
+    for(int i=0; i<copy.data()->item.data()->size(); i++) (*copy.data()->item.data())[i].GIData._item = NULL;
+    return copy;
+}
+
+
+QVector<GraphicsItemData> ComicMetadata::getGraphicsItemList(ComicMetadataType type)
+{
+    QVector<GraphicsItemData> GraphicsItemList;
+    switch(type){
+    case ComicMetadata_Frame:
+        for(int i=0; i<frame.data()->size();i++){
+            GraphicsItemList.push_back(frame.data()->at(i).GIData);
+        }
+        break;
+    case ComicMetadata_Character:
+        for(int i=0; i<character.data()->size();i++){
+            GraphicsItemList.push_back(character.data()->at(i).GIData);
+        }
+        break;
+    case ComicMetadata_Dialog:
+        for(int i=0; i<dialog.data()->size();i++){
+            GraphicsItemList.push_back(dialog.data()->at(i).GIData);
+        }
+        break;
+    case ComicMetadata_Onomatopoeia:
+        for(int i=0; i<onomatopoeia.data()->size();i++){
+            GraphicsItemList.push_back(onomatopoeia.data()->at(i).GIData);
+        }
+        break;
+    default:
+        break;
+    }
+    return GraphicsItemList;
+}
+
+void ComicMetadata::clear()
+{
+    clearCommon();
+    clearPageMetadata();
+}
+void ComicMetadata::clearCommon()
+{
+    workTitle.clear();
+    episodeNumber = -1;
+    pageNumber = 0;
+    clearCharacterName();
+    imageFileName = "";
+}
+void ComicMetadata::clearPageMetadata()
+{
+    frame.data()->clear();
+    character.data()->clear();
+    dialog.data()->clear();
+    onomatopoeia.data()->clear();
+    item.data()->clear();
+    for(int i=0; i<ComicMetadata_All; i++){
+        _ids[i].clear();
+    }
+}
+
+void ComicMetadata::deleteItem(ComicMetadataType target, int number)
+{
+    if(target < ComicMetadata_Frame || target >= ComicMetadata_All) return;
+    if(number < 0 || number >= itemCount(target)) return;
+
+    QVector<quint32> previousFrameIds;
+    if(target == ComicMetadata_Frame) previousFrameIds = frameIds();
+    idIndex(target).removeAt(number);
+
+    switch(target){
+    case ComicMetadata_Frame:
+        frame.data()->removeAt(number);
+        break;
+    case ComicMetadata_Character:
+        character.data()->removeAt(number);
+        break;
+    case ComicMetadata_Dialog:
+        dialog.data()->removeAt(number);
+        break;
+    case ComicMetadata_Onomatopoeia:
+        onomatopoeia.data()->removeAt(number);
+        break;
+    case ComicMetadata_Item:
+        item.data()->removeAt(number);
+        break;
+    default:
+        break;
+    }
+    if(target == ComicMetadata_Frame) updateTargetFrame(previousFrameIds);
+    markChanged(target);
+}
+
+/*!
+ * \brief リストを並べ替える
+ * \param list 並べ替えるリスト
+ * \param order 並べ替え後のi番目の要素の、並べ替え前の番号
+ */
+template<class T>
+static void reorderList(QVector<T> &list, const QVector<int> &order)
+{
+    QVector<T> reordered;
+    reordered.reserve(order.size());
+    for(int i=0; i<order.size(); i++){
+        reordered.push_back(list.at(order.at(i)));
+    }
+    list.swap(reordered);
+}
+
+/*!
+ * \brief 注釈のリストの対象コマを新しい番号に置き換える
+ * \param list 注釈のリスト
+ * \param newFrame 変更前のコマ番号毎の変更後のコマ番号（0は対象コマ無し）
+ * \return 置き換えた注釈が有った場合true
+ */
+template<class T>
+static bool remapTargetFrame(QVector<T> &list, const QVector<int> &newFrame)
+{
+    bool changed = false;
+    for(int i=0; i<list.size(); i++){
+        int target = list.at(i).targetFrame;
+        if(target <= 0 || target >= newFrame.size()) continue;
+        if(newFrame.at(target) == target) continue;
+        list[i].targetFrame = newFrame.at(target);
+        changed = true;
+    }
+    return changed;
+}
+
+bool ComicMetadata::reorderItems(ComicMetadataType type, const QVector<int> &order)
+{
+    if(type < ComicMetadata_Frame || type >= ComicMetadata_All) return false;
+
+    QVector<quint32> previousFrameIds;
+    if(type == ComicMetadata_Frame) previousFrameIds = frameIds();
+    if(!idIndex(type).reorder(order)) return false;
+
+    switch(type){
+    case ComicMetadata_Frame:
+        reorderList(*frame.data(), order);
+        break;
+    case ComicMetadata_Character:
+        reorderList(*character.data(), order);
+        break;
+    case ComicMetadata_Dialog:
+        reorderList(*dialog.data(), order);
+        break;
+    case ComicMetadata_Onomatopoeia:
+        reorderList(*onomatopoeia.data(), order);
+        break;
+    case ComicMetadata_Item:
+        reorderList(*item.data(), order);
+        break;
+    default:
+        break;
+    }
+    if(type == ComicMetadata_Frame) updateTargetFrame(previousFrameIds);
+    markChanged(type);
+    return true;
+}
+
+quint32 ComicMetadata::itemId(ComicMetadataType type, int number) const
+{
+    if(type < ComicMetadata_Frame || type >= ComicMetadata_All) return 0;
+    return idIndex(type).id(number);
+}
+
+int ComicMetadata::itemNumber(ComicMetadataType type, quint32 id) const
+{
+    if(type < ComicMetadata_Frame || type >= ComicMetadata_All) return -1;
+    return idIndex(type).number(id);
+}
+
+int ComicMetadata::itemCount(ComicMetadataType type) const
+{
+    switch(type){
+    case ComicMetadata_Frame:
+        return frame.data()->size();
+    case ComicMetadata_Character:
+        return character.data()->size();
+    case ComicMetadata_Dialog:
+        return dialog.data()->size();
+    case ComicMetadata_Onomatopoeia:
+        return onomatopoeia.data()->size();
+    case ComicMetadata_Item:
+        return item.data()->size();
+    default:
+        return 0;
+    }
+}
+
+StableIdIndex &ComicMetadata::idIndex(ComicMetadataType type) const
+{
+    StableIdIndex &index = _ids[type];
+    int count = itemCount(type);
+    //!要素の削除はdeleteItem、読み込み時の消去はclearPageMetadataを経由するため、リストが直接縮められることはない
+    //万一縮められていた場合、デバッグビルドでは停止し、リリースビルドではIDを振り直す
+    Q_ASSERT_X(index.size() <= count, "ComicMetadata::idIndex",
+               "list was shrunk without deleteItem/clearPageMetadata");
+    if(index.size() > count) index.clear();
+    //!リストの末尾に直接追加された要素にIDを割り当てる
+    while(index.size() < count) index.append();
+    return index;
+}
+
+QVector<quint32> ComicMetadata::frameIds() const
+{
+    const StableIdIndex &index = idIndex(ComicMetadata_Frame);
+    QVector<quint32> ids(index.size());
+    for(int i=0; i<ids.size(); i++){
+        ids[i] = index.id(i);
+    }
+    return ids;
+}
+
+void ComicMetadata::updateTargetFrame(const QVector<quint32> &previousFrameIds)
+{
+    //!変更前のコマ番号から変更後のコマ番号への対応表を、IDを介して作る（削除されたコマは0）
+    const StableIdIndex &index = idIndex(ComicMetadata_Frame);
+    QVector<int> newFrame(previousFrameIds.size() + 1, 0);
+    for(int i=0; i<previousFrameIds.size(); i++){
+        newFrame[i+1] = index.number(previousFrameIds.at(i)) + 1;
+    }
+
+    //!各注釈の対象コマを置き換える
+    if(remapTargetFrame(*character.data(), newFrame)) markChanged(ComicMetadata_Character);
+    if(remapTargetFrame(*dialog.data(), newFrame)) markChanged(ComicMetadata_Dialog);
+    if(remapTargetFrame(*onomatopoeia.data(), newFrame)) markChanged(ComicMetadata_Onomatopoeia);
+    if(remapTargetFrame(*item.data(), newFrame)) markChanged(ComicMetadata_Item);
+}
+
+FrameData &ComicMetadata::editFrame(int number)
+{
+    markChanged(ComicMetadata_Frame);
+    return (*frame.data())[number];
+}
+
+CharacterData &ComicMetadata::editCharacter(int number)
+{
+    markChanged(ComicMetadata_Character);
+    return (*character.data())[number];
+}
+
+DialogData &ComicMetadata::editDialog(int number)
+{
+    markChanged(ComicMetadata_Dialog);
+    return (*dialog.data())[number];
+}
+
+OnomatopoeiaData &ComicMetadata::editOnomatopoeia(int number)
+{
+    markChanged(ComicMetadata_Onomatopoeia);
+    return (*onomatopoeia.data())[number];
+}
+
+ItemData &ComicMetadata::editItem(int number)
+{
+    markChanged(ComicMetadata_Item);
+    return (*item.data())[number];
+}
+
+void ComicMetadata::markChanged(ComicMetadataType type)
+{
+    switch(type){
+    case ComicMetadata_Frame:
+        _changed |= ComicMetadataChange_Frame;
+        break;
+    case ComicMetadata_Character:
+        _changed |= ComicMetadataChange_Character;
+        break;
+    case ComicMetadata_Dialog:
+        _changed |= ComicMetadataChange_Dialog;
+        break;
+    case ComicMetadata_Onomatopoeia:
+        _changed |= ComicMetadataChange_Onomatopoeia;
+        break;
+    case ComicMetadata_Item:
+        _changed |= ComicMetadataChange_Item;
+        break;
+    case ComicMetadata_All:
+        _changed |= ComicMetadataChange_Page;
+        break;
+    default:
+        break;
+    }
+}
+
+void ComicMetadata::markCommonChanged()
+{
+    _changed |= ComicMetadataChange_Common;
+}
+
+void ComicMetadata::markPageInfoChanged()
+{
+    _changed |= ComicMetadataChange_PageInfo;
+}
+
+int ComicMetadata::changedFlags() const
+{
+    return _changed;
+}
+
+bool ComicMetadata::isChanged() const
+{
+    return _changed != ComicMetadataChange_None;
+}
+
+bool ComicMetadata::isCommonChanged() const
+{
+    return (_changed & ComicMetadataChange_Common) != 0;
+}
+
+bool ComicMetadata::isPageChanged() const
+{
+    return (_changed & ComicMetadataChange_Page) != 0;
+}
+
+void ComicMetadata::clearChanged()
+{
+    _changed = ComicMetadataChange_None;
+    for(int section = ComicMetadataChange_Common; section <= ComicMetadataChange_Item; section <<= 1){
+        _savedFingerprint.insert(section, fingerprint(ComicMetadataChange(section)));
+    }
+}
+
+void ComicMetadata::dropUnchangedFlags()
+{
+    for(int section = ComicMetadataChange_Common; section <= ComicMetadataChange_Item; section <<= 1){
+        if(!(_changed & section)) continue;
+        if(_savedFingerprint.contains(section)
+                && _savedFingerprint.value(section) == fingerprint(ComicMetadataChange(section))){
+            _changed &= ~section;
+        }
+    }
+}
+
+/*!
+ * \brief 指定箇所の出力対象となる値をすべて連結し、そのハッシュ値を求める
+ * \param section 対象箇所（単一のフラグ）
+ * \return ハッシュ値
+ */
+QByteArray ComicMetadata::fingerprint(ComicMetadataChange section) const
+{
+    QByteArray buffer;
+    QDataStream stream(&buffer, QIODevice::WriteOnly);
+    switch(section){
+    case ComicMetadataChange_Common:
+        stream << workTitle << characterName;
+        break;
+    case ComicMetadataChange_PageInfo:
+        stream << episodeNumber << pageNumber << imageFileName << imageWidth << imageHeight;
+        break;
+    case ComicMetadataChange_Frame:
+        for(int i=0; i<frame.data()->size(); i++){
+            const FrameData &data = frame.data()->at(i);
+            stream << mangaPath(ComicMetadata_Frame, i) << data.sceneBoundary << data.GIData._relativePosition;
+        }
+        break;
+    case ComicMetadataChange_Character:
+        for(int i=0; i<character.data()->size(); i++){
+            const CharacterData &data = character.data()->at(i);
+            stream << mangaPath(ComicMetadata_Character, i) << data.characterID << data.characterName
+                   << data.targetFrame << data.GIData._relativePosition;
+        }
+        break;
+    case ComicMetadataChange_Dialog:
+        for(int i=0; i<dialog.data()->size(); i++){
+            const DialogData &data = dialog.data()->at(i);
+            stream << mangaPath(ComicMetadata_Dialog, i) << data.targetCharacterID << data.characterName
+                   << data.fontSize << data.narration << data.text
+                   << data.targetFrame << data.GIData._relativePosition;
+        }
+        break;
+    case ComicMetadataChange_Onomatopoeia:
+        for(int i=0; i<onomatopoeia.data()->size(); i++){
+            const OnomatopoeiaData &data = onomatopoeia.data()->at(i);
+            stream << mangaPath(ComicMetadata_Onomatopoeia, i) << data.fontSize << data.text
+                   << data.targetFrame << data.GIData._relativePosition;
+        }
+        break;
+    case ComicMetadataChange_Item:
+        for(int i=0; i<item.data()->size(); i++){
+            const ItemData &data = item.data()->at(i);
+            stream << mangaPath(ComicMetadata_Item, i) << data.itemClass << data.description
+                   << data.targetFrame << data.GIData._relativePosition;
+        }
+        break;
+    default:
+        break;
+    }
+    return QCryptographicHash::hash(buffer, QCryptographicHash::Md5);
+}
+
+
+void OnomatopoeiaData::setText(QString str){
+    text = str;
+}
+
+QString ComicMetadata::mangaPath(ComicMetadataType type, int number) const
+{
+    switch(type){
+    case ComicMetadata_Frame:
+        if(number < 0 || number >= frame.data()->size()) break;
+        return MangaPath_title_episode_page_frame(number+1);
+    case ComicMetadata_Character:
+        if(number < 0 || number >= character.data()->size()) break;
+        return MangaPath_title_episode_page_frame(character.data()->at(number).targetFrame)
+                + QString("c%1/").arg(number+1, 3, 10, QChar('0'));
+    case ComicMetadata_Dialog:
+        if(number < 0 || number >= dialog.data()->size()) break;
+        return MangaPath_title_episode_page_frame(dialog.data()->at(number).targetFrame)
+                + QString("d%1/").arg(number+1, 3, 10, QChar('0'));
+    case ComicMetadata_Onomatopoeia:
+        if(number < 0 || number >= onomatopoeia.data()->size()) break;
+        return MangaPath_title_episode_page_frame(onomatopoeia.data()->at(number).targetFrame)
+                + QString("o%1").arg(number+1, 3, 10, QChar('0'));
+    case ComicMetadata_Item:
+        if(number < 0 || number >= item.data()->size()) break;
+        return MangaPath_title_episode_page_frame(item.data()->at(number).targetFrame)
+                + QString("i%1").arg(number+1, 3, 10, QChar('0'));
+    default:
+        break;
+    }
+    return QString();
+}
+
+QString ComicMetadata::MangaPath_title_episode() const
+{
+    QString str;
+    if(!workTitle.isEmpty()){
+        str += workTitle;
+        str += "/";
+    }
+    if(episodeNumber > -1){
+        str += QString("e%1/").arg(episodeNumber, 4, 10, QChar('0'));
+    }
+    return str;
+}
+
+QString ComicMetadata::MangaPath_page() const
+{
+    QString str;
+    if(pageNumber > -1){
+        str = QString("p%1/").arg(pageNumber, 4, 10, QChar('0'));
+    }
+    return str;
+}
+
+QString ComicMetadata::MangaPath_frame(int number) const
+{
+    QString str;
+    if(number > -1){
+        str = QString("f%1/").arg(number, 3, 10, QChar('0'));
+    }
+    return str;
+}
+
+QString ComicMetadata::MangaPath_title_episode_page_frame(int frameNumber) const
+{
+    QString str;
+    str += MangaPath_title_episode();
+    str += MangaPath_page();
+    str += MangaPath_frame(frameNumber);
+    return str;
+}
+
+
+/*!
+ * \brief 要素名を大文字小文字を区別せずに比較する
+ * \param reader 開始タグの位置にあるXMLリーダー
+ * \param tag 比較する要素名
+ * \return 一致した場合true
+ */
+static bool isTag(const QXmlStreamReader &reader, const char *tag)
+{
+    return 0 == reader.qualifiedName().compare(QLatin1String(tag), Qt::CaseInsensitive);
+}
+
+/*!
+ * \brief 現在の要素の最初の子ノードのテキストを読み込み、要素の終わりまで読み進める
+ * DOMでのfirstChild().toText().data()と同じ結果を返す（空白のみのテキストは無視し、
+ * 最初の子ノードがテキスト・CDATA以外の場合は空文字列とする）
+ * \param reader 開始タグの位置にあるXMLリーダー
+ * \param isTextNode 最初の子ノードが（CDATAではない）テキストであった場合trueを格納する
+ * \return テキスト
+ */
+static QString readFirstText(QXmlStreamReader &reader, bool *isTextNode = NULL)
+{
+    QString text;
+    bool found = false; //!< 最初の子ノードがテキストであった
+    bool cdata = false; //!< 最初の子ノードがCDATAであった
+    bool determined = false; //!< 最初の子ノードが確定した
+    int depth = 1;
+    while(!reader.atEnd()){
+        QXmlStreamReader::TokenType token = reader.readNext();
+        if(token == QXmlStreamReader::Invalid) break;
+        if(token == QXmlStreamReader::StartElement){
+            depth++;
+            determined = true;
+            continue;
+        }
+        if(token == QXmlStreamReader::EndElement){
+            depth--;
+            if(depth == 0) break;
+            continue;
+        }
+        if(depth != 1 || determined) continue;
+        if(token == QXmlStreamReader::Characters){
+            if(!found){
+                if(reader.isWhitespace() && !reader.isCDATA()) continue;
+                found = true;
+                cdata = reader.isCDATA();
+                text = reader.text().toString();
+            }
+            else if(!cdata && !reader.isCDATA()){
+                text += reader.text().toString();
+            }
+            else{
+                determined = true;
+            }
+            continue;
+        }
+        determined = true;
+    }
+    if(isTextNode != NULL) *isTextNode = found && !cdata;
+    return text;
+}
+
+bool ComicMetadata::loadMetadata_Common(QString fileName)
+{
+    //!処理概要
+    clearCommon();
+    //!- ファイルを開く
+    QFile file(fileName);
+
+    //!- ファイルが開けない場合は何もせず終了
+    if(!file.open(QFile::ReadOnly)) return false;
+    return loadMetadata_Common(&file);
+}
+
+bool ComicMetadata::loadMetadata_Common(QIODevice *device)
+{
+    clearCommon();
+
+    //!- ComicMetadata以外のXMLファイルの場合終了
+    QXmlStreamReader reader(device);
+    if(!reader.readNextStartElement() || reader.qualifiedName() != QLatin1String("ComicMetadata")){
+        clearCommon();
+        return false;
+    }
+
+    //!- 実際にメタデータ本体を読み込む
+    while(reader.readNextStartElement()){
+        if(reader.qualifiedName() == QLatin1String("BookData")){
+            bool isTextNode = false;
+            QString title = readFirstText(reader, &isTextNode);
+            if(isTextNode) workTitle = title;
+        }
+        else if(reader.qualifiedName() == QLatin1String("CharacterData")){
+            XMLPurse_CharacterList(reader);
+        }
+        else{
+            reader.skipCurrentElement();
+        }
+    }
+
+    //!- 文書の最後まで読み、XMLとして不正な箇所があれば読み込んだ内容を破棄する
+    while(!reader.atEnd()) reader.readNext();
+    if(reader.hasError()){
+        clearCommon();
+        return false;
+    }
+
+    //!終了
+    return true;
+}
+
+void ComicMetadata::clearLoadArea()
+{
+    loadFrame.clear();
+    loadFrameCoordinate.clear();
+    loadCharacter.clear();
+    loadCharacterCoordinate.clear();
+    loadDialog.clear();
+    loadDialogCoordinate.clear();
+    loadOnomatopoeia.clear();
+    loadOnomatopoeiaCoordinate.clear();
+    loadItem.clear();
+    loadItemCoordinate.clear();
+    loadEpisodeNumber = -1;
+    loadPageNumber = 0;
+}
+
+bool ComicMetadata::loadMetadata_Page(QString fileName, int targetPageNumber)
+{
+    clearPageMetadata();
+    clearLoadArea();
+
+    QFile file(fileName);
+    if(!file.open(QFile::ReadOnly)) return false;
+    return loadMetadata_Page(&file, targetPageNumber);
+}
+
+bool ComicMetadata::loadMetadata_Page(QIODevice *device, int targetPageNumber)
+{
+    clearPageMetadata();
+    clearLoadArea();
+
+    //読み込めなかった場合終了
+    //ComicMetadata以外のXMLファイルの場合終了
+    QString previousImageFileName = loadImageFileName;
+    QXmlStreamReader reader(device);
+    if(!reader.readNextStartElement() || reader.qualifiedName() != QLatin1String("ComicMetadata")){
+        return false;
+    }
+
+    while(reader.readNextStartElement()){
+        //読み込んだものがページデータなら展開する
+        if(!isTag(reader, "PageData")){
+            reader.skipCurrentElement();
+            continue;
+        }
+        bool pageStatus = true;
+        while(pageStatus && reader.readNextStartElement()){
+            if(isTag(reader, "EpisodeNumber")){
+                QString str = readFirstText(reader);
+                if(0 == QString::compare(str, "NoData", Qt::CaseInsensitive)){
+                    loadEpisodeNumber = -1;
+                }
+                else{
+                    int num = str.toInt();
+                    if(num >= 0) loadEpisodeNumber = num;
+                    else loadEpisodeNumber = 0;
+                }
+            }
+            else if(isTag(reader, "PageNumber")){
+                loadPageNumber = readFirstText(reader).toInt();
+                //targetPageNumberを指定してXMLデータを読み込む部分は後日作成したい
+                if(targetPageNumber >=0 && loadPageNumber != targetPageNumber){
+                    pageStatus = false;
+                }
+            }
+            else if(isTag(reader, "FileName")){
+                loadImageFileName = readFirstText(reader);
+            }
+            else if(isTag(reader, "FrameData")){
+                XMLPurse_Frame(reader);
+            }
+            else if(isTag(reader, "CharacterData")){
+                XMLPurse_Character(reader);
+            }
+            else if(isTag(reader, "DialogData")){
+                XMLPurse_Dialog(reader);
+            }
+            else if(isTag(reader, "OnomatopoeiaData")){
+                XMLPurse_Onomatopoeia(reader);
+            }
+            else if(isTag(reader, "ItemData")){
+                XMLPurse_Item(reader);
+            }
+            else{
+                reader.skipCurrentElement();
+            }
+        }
+        //対象外のページであれば残りを読み飛ばす
+        if(!pageStatus) reader.skipCurrentElement();
+    }
+
+    //文書の最後まで読み、XMLとして不正な箇所があれば読み込んだ内容を破棄する
+    while(!reader.atEnd()) reader.readNext();
+    if(reader.hasError()){
+        clearLoadArea();
+        loadImageFileName = previousImageFileName;
+        return false;
+    }
+    return true;
+}
+
+bool ComicMetadata::writeMetadata_Common(QString fileName)
+{
+    //!一時ファイルに書き込み、完了してから置き換える（書き込み途中で中断されても元のファイルが残る）
+    QSaveFile file(fileName);
+    if(!file.open(QFile::WriteOnly)){
+        return false;
+    }
+    if(!writeMetadata_Common(&file)){
+        file.cancelWriting();
+        return false;
+    }
+    if(!file.commit()) return false;
+    std::cout << "Output XML(Common) : " << fileName.toStdString() << std::endl;
+    return true;
+}
+
+bool ComicMetadata::writeMetadata_Common(QIODevice *device)
+{
+    QXmlStreamWriter writer(device);
+    writer.setAutoFormatting(true);
+    writer.setAutoFormattingIndent(indent);
+
+    //comic metadata root
+    writer.writeStartElement("ComicMetadata");
+
+    //book data
+    writer.writeTextElement("BookData", workTitle);
+
+    //character data
+    writer.writeStartElement("CharacterData");
+    for(int i=0; i<characterName.size(); i++){
+        //Entry
+        writer.writeTextElement("Character", characterName.at(i));
+    }
+    writer.writeEndElement();
+
+    writer.writeEndElement();
+    return !writer.hasError();
+}
+
+bool ComicMetadata::writeMetadata_Page(QString fileName)
+{
+//    std::cout << "writeMetadata_Page" << std::endl;
+    //!一時ファイルに書き込み、完了してから置き換える（書き込み途中で中断されても元のファイルが残る）
+    QSaveFile file(fileName);
+    if(!file.open(QFile::WriteOnly)){
+        return false;
+    }
+    if(!writeMetadata_Page(&file)){
+        file.cancelWriting();
+        return false;
+    }
+    if(!file.commit()) return false;
+    std::cout << "Output XML(Page) : " << fileName.toStdString() << std::endl;
+    return true;
+}
+
+bool ComicMetadata::writeMetadata_Page(QIODevice *device)
+{
+    QXmlStreamWriter writer(device);
+    writer.setAutoFormatting(true);
+    writer.setAutoFormattingIndent(indent);//インデントのスペース数
+
+    //Comic metadata root
+    writer.writeStartElement("ComicMetadata");
+
+    //Page data
+    writer.writeStartElement("PageData");
+
+    //Episode Number
+    QString episode_str;
+    if(episodeNumber < 0){
+        episode_str = ("NoData");
+    }
+    else{
+        episode_str = QString("%1").arg(episodeNumber,4,10,QChar('0'));
+    }
+    writer.writeTextElement("EpisodeNumber", episode_str);
+
+    //File Name
+    writer.writeTextElement("FileName", imageFileName);
+
+    //Page Number
+    writer.writeTextElement("PageNumber", QString("%1").arg(pageNumber,4,10,QChar('0')));
+
+    //Image Size
+    writer.writeStartElement("ImageSize");
+    writer.writeTextElement("Width", QString::number(imageWidth));
+    writer.writeTextElement("Height", QString::number(imageHeight));
+    writer.writeEndElement();
+
+    XMLCreate_Frame(writer);
+    XMLCreate_Character(writer);
+    XMLCreate_Dialog(writer);
+    XMLCreate_Onomatopoeia(writer);
+    XMLCreate_Item(writer);
+
+    writer.writeEndElement();
+    writer.writeEndElement();
+    return !writer.hasError();
+}
+
+void ComicMetadata::XMLCreate_Frame(QXmlStreamWriter &writer)
+{
+    //frame
+    writer.writeStartElement("FrameData");
+    for(int i=0; i<frame.data()->size(); i++){
+        const FrameData &data = frame.data()->at(i);
+        writer.writeStartElement("Frame");
+
+        //mangaPath
+        writer.writeTextElement("MangaPath", mangaPath(ComicMetadata_Frame, i));
+
+        //scene change
+        if(data.sceneBoundary){
+            writer.writeTextElement("SceneChange", "1");
+        }
+        else{
+            writer.writeTextElement("SceneChange", "0");
+        }
+
+        //coordinate
+        XMLCreate_Coordinage(writer, data.GIData);
+        writer.writeEndElement();
+    }
+    writer.writeEndElement();
+}
+
+void ComicMetadata::XMLCreate_Character(QXmlStreamWriter &writer)
+{
+    //character
+    writer.writeStartElement("CharacterData");
+    for(int i=0; i<character.data()->size(); i++){
+        const CharacterData &data = character.data()->at(i);
+        writer.writeStartElement("Character");
+
+        //mangaPath
+        writer.writeTextElement("MangaPath", mangaPath(ComicMetadata_Character, i));
+
+        //character id
+        writer.writeTextElement("CharacterID", QString("%1").arg(data.characterID, 3, 10, QChar('0')));
+
+        //character name
+        writer.writeTextElement("CharacterName", data.characterName);
+
+        //target frame
+        writer.writeTextElement("Frame", QString("%1").arg(data.targetFrame, 3, 10, QChar('0')));
+
+        //coordinate
+        XMLCreate_Coordinage(writer, data.GIData);
+        writer.writeEndElement();
+    }
+    writer.writeEndElement();
+}
+
+void ComicMetadata::XMLCreate_Dialog(QXmlStreamWriter &writer)
+{
+    //dialog
+    writer.writeStartElement("DialogData");
+    for(int i=0; i<dialog.data()->size(); i++){
+        const DialogData &data = dialog.data()->at(i);
+        writer.writeStartElement("Dialog");
+
+        //mangaPath
+        writer.writeTextElement("MangaPath", mangaPath(ComicMetadata_Dialog, i));
+
+        //speaker
+        //従来の出力形式に合わせ、話者名はSpeakerNameではなくSpeaker直下に出力する
+        writer.writeStartElement("Speaker");
+        writer.writeTextElement("SpeakerID", QString("%1").arg(data.targetCharacterID, 3, 10, QChar('0')));
+        writer.writeEmptyElement("SpeakerName");
+        writer.writeCharacters(data.characterName);
+        writer.writeEndElement();
+
+        //font size
+        writer.writeTextElement("FontSize", QString::number(data.fontSize));
+
+        //DialogType dialog or narration
+        if(data.narration){
+            writer.writeTextElement("DialogType", "Narration");
+        }
+        else{
+            writer.writeTextElement("DialogType", "Dialog");
+        }
+
+        //Text
+        writer.writeTextElement("Text", data.text);
+
+        //target frame
+        writer.writeTextElement("Frame", QString("%1").arg(data.targetFrame, 3, 10, QChar('0')));
+
+        //coordinate
+        XMLCreate_Coordinage(writer, data.GIData);
+        writer.writeEndElement();
+    }
+    writer.writeEndElement();
+}
+
+void ComicMetadata::XMLCreate_Onomatopoeia(QXmlStreamWriter &writer)
+{
+    //onomatopoeia
+    writer.writeStartElement("OnomatopoeiaData");
+    for(int i=0; i<onomatopoeia.data()->size(); i++){
+        const OnomatopoeiaData &data = onomatopoeia.data()->at(i);
+        writer.writeStartElement("Onomatopoeia");
+
+        //mangaPath
+        writer.writeTextElement("MangaPath", mangaPath(ComicMetadata_Onomatopoeia, i));
+
+        //font size
+        writer.writeTextElement("FontSize", QString::number(data.fontSize));
+
+        //Text
+        writer.writeTextElement("Text", data.text);
+
+        //target frame
+        writer.writeTextElement("Frame", QString("%1").arg(data.targetFrame, 3, 10, QChar('0')));
+
+        //coordinate
+        XMLCreate_Coordinage(writer, data.GIData);
+        writer.writeEndElement();
+    }
+    writer.writeEndElement();
+}
+
+void ComicMetadata::XMLCreate_Item(QXmlStreamWriter &writer)
+{
+    //item
+    writer.writeStartElement("ItemData");
+    for(int i=0; i<item.data()->size(); i++){
+        const ItemData &data = item.data()->at(i);
+        writer.writeStartElement("Item");
+
+        //mangaPath
+        writer.writeTextElement("MangaPath", mangaPath(ComicMetadata_Item, i));
+
+        //itemClass
+        writer.writeTextElement("Class", data.itemClass);
+
+        //Description
+        writer.writeTextElement("Description", data.description);
+
+        //target frame
+        writer.writeTextElement("Frame", QString("%1").arg(data.targetFrame, 3, 10, QChar('0')));
+
+        //coordinate
+        XMLCreate_Coordinage(writer, data.GIData);
+        writer.writeEndElement();
+    }
+    writer.writeEndElement();
+}
+
+void ComicMetadata::XMLPurse_CharacterList(QXmlStreamReader &reader)
+{
+    clearCharacterName();
+    while(reader.readNextStartElement()){
+        if(reader.qualifiedName() == QLatin1String("Character")){
+            QString name = readFirstText(reader);
+            if(0 != QString::compare(name, UnDefinedCharacterName, Qt::CaseInsensitive)){
+                characterName.push_back(name);
+            }
+        }
+        else{
+            reader.skipCurrentElement();
+        }
+    }
+}
+
+void ComicMetadata::XMLCreate_Coordinage(QXmlStreamWriter &writer, const GraphicsItemData &GIData)
+{
+    //座標値は従来のQString("%1").arg(double)と同じ書式（有効数字6桁）で出力する
+    const QPolygonF &polygon = GIData._relativePosition;
+    writer.writeStartElement("Coordinate");
+    for(int i=0; i<polygon.size(); i++){
+        const QPointF &pt = polygon.at(i);
+        writer.writeStartElement("Point");
+        writer.writeTextElement("X", QString::number(pt.x(), 'g', 6));
+        writer.writeTextElement("Y", QString::number(pt.y(), 'g', 6));
+        writer.writeEndElement();
+    }
+    writer.writeEndElement();
+}
+
+QPolygonF ComicMetadata::XMLPurse_Coordinate(QXmlStreamReader &reader){
+    QPolygonF polygon;
+    if(!isTag(reader, "Coordinate")){
+        reader.skipCurrentElement();
+        return polygon;
+    }
+
+    while(reader.readNextStartElement()){
+        if(isTag(reader, "Point")){
+            QPointF pt(0.0, 0.0);
+            while(reader.readNextStartElement()){
+                if(isTag(reader, "X")){
+                    pt.setX(readFirstText(reader).toDouble());
+                }
+                else if(isTag(reader, "Y")){
+                    pt.setY(readFirstText(reader).toDouble());
+                }
+                else{
+                    reader.skipCurrentElement();
+                }
+            }
+            polygon.push_back(pt);
+        }
+        else{
+            reader.skipCurrentElement();
+        }
+    }
+    return polygon;
+}
+
+/*!
+ * \brief 要素内の数値を読み込む。0未満である場合には0とする
+ * \param reader 開始タグの位置にあるXMLリーダー
+ * \return 読み込んだ数値
+ */
+static int readNonNegativeInt(QXmlStreamReader &reader)
+{
+    int val = readFirstText(reader).toInt();
+    if(val >= 0) return val;
+    return 0;
+}
+
+void ComicMetadata::XMLPurse_Frame(QXmlStreamReader &reader)
+{
+//    std::cout << "purse frame" << std::endl;
+    if(!isTag(reader, "FrameData")){
+        reader.skipCurrentElement();
+        return;
+    }
+    while(reader.readNextStartElement()){
+        //frameであれば展開してデータを入れる
+        if(!isTag(reader, "Frame")){
+            reader.skipCurrentElement();
+            continue;
+        }
+        FrameData localFrame;
+        QPolygonF localPolygon;
+        while(reader.readNextStartElement()){
+            if(isTag(reader, "SceneChange")){
+                int val = readFirstText(reader).toInt();
+                if(val == 1)localFrame.sceneBoundary = true;
+                else localFrame.sceneBoundary = false;
+            }
+            else if(isTag(reader, "Coordinate")){
+                localPolygon = XMLPurse_Coordinate(reader);
+            }
+            else{
+                reader.skipCurrentElement();
+            }
+        }
+        loadFrame.push_back(localFrame);
+        loadFrameCoordinate.push_back(localPolygon);
+    }
+}
+/**
+ * @brief ComicMetadata::XMLPurse_Character
+ * @param reader
+ * CharacterIDが0未満である場合には強制的に0にリセット
+ */
+void ComicMetadata::XMLPurse_Character(QXmlStreamReader &reader)
+{
+//    std::cout << "purse character" << std::endl;
+    if(!isTag(reader, "CharacterData")){
+        reader.skipCurrentElement();
+        return;
+    }
+    while(reader.readNextStartElement()){
+        //Characterであれば展開してデータを入れる
+        if(!isTag(reader, "Character")){
+            reader.skipCurrentElement();
+            continue;
+        }
+        CharacterData localData;
+        QPolygonF localPolygon;
+        while(reader.readNextStartElement()){
+            if(isTag(reader, "CharacterID")){
+                localData.characterID = readNonNegativeInt(reader);
+            }
+            else if(isTag(reader, "CharacterName")){
+                localData.characterName = readFirstText(reader);
+            }
+            else if(isTag(reader, "Frame")){
+                localData.targetFrame = readNonNegativeInt(reader);
+            }
+            else if(isTag(reader, "Coordinate")){
+                localPolygon = XMLPurse_Coordinate(reader);
+            }
+            else{
+                reader.skipCurrentElement();
+            }
+        }
+        loadCharacter.push_back(localData);
+        loadCharacterCoordinate.push_back(localPolygon);
+    }
+}
+
+void ComicMetadata::XMLPurse_Dialog(QXmlStreamReader &reader)
+{
+//    std::cout << "purse dialog" << std::endl;
+    if(!isTag(reader, "DialogData")){
+        reader.skipCurrentElement();
+        return;
+    }
+    while(reader.readNextStartElement()){
+        //Dialogであれば展開してデータを入れる
+        if(!isTag(reader, "Dialog")){
+            reader.skipCurrentElement();
+            continue;
+        }
+        DialogData localData;
+        QPolygonF localPolygon;
+        while(reader.readNextStartElement()){
+            if(isTag(reader, "Speaker")){
+                while(reader.readNextStartElement()){
+                    if(isTag(reader, "SpeakerID")){
+                        localData.targetCharacterID = readNonNegativeInt(reader);
+                    }
+                    else if(isTag(reader, "SpeakerName")){
+                        localData.characterName = readFirstText(reader);
+                    }
+                    else{
+                        reader.skipCurrentElement();
+                    }
+                }
+            }
+            else if(isTag(reader, "FontSize")){
+                localData.fontSize = readNonNegativeInt(reader);
+            }
+            else if(isTag(reader, "DialogType")){
+                QString dtype = readFirstText(reader);
+                if(0 == QString::compare(dtype, "Narration", Qt::CaseInsensitive))
+                    localData.narration = true;
+                else localData.narration = false;
+            }
+            else if(isTag(reader, "Text")){
+                localData.text = readFirstText(reader);
+            }
+            else if(isTag(reader, "Frame")){
+                localData.targetFrame = readNonNegativeInt(reader);
+            }
+            else if(isTag(reader, "Coordinate")){
+                localPolygon = XMLPurse_Coordinate(reader);
+            }
+            else{
+                reader.skipCurrentElement();
+            }
+        }
+        loadDialog.push_back(localData);
+        loadDialogCoordinate.push_back(localPolygon);
+    }
+}
+
+void ComicMetadata::XMLPurse_Onomatopoeia(QXmlStreamReader &reader)
+{
+//    std::cout << "purse onomatopoeia" << std::endl;
+    if(!isTag(reader, "OnomatopoeiaData")){
+        reader.skipCurrentElement();
+        return;
+    }
+    while(reader.readNextStartElement()){
+        //Onomatopoeiaであれば展開してデータを入れる
+        if(!isTag(reader, "Onomatopoeia")){
+            reader.skipCurrentElement();
+            continue;
+        }
+        OnomatopoeiaData localData;
+        QPolygonF localPolygon;
+        while(reader.readNextStartElement()){
+            if(isTag(reader, "FontSize")){
+                localData.fontSize = readNonNegativeInt(reader);
+            }
+            else if(isTag(reader, "Text")){
+                localData.text = readFirstText(reader);
+            }
+            else if(isTag(reader, "Frame")){
+                localData.targetFrame = readNonNegativeInt(reader);
+            }
+            else if(isTag(reader, "Coordinate")){
+                localPolygon = XMLPurse_Coordinate(reader);
+            }
+            else{
+                reader.skipCurrentElement();
+            }
+        }
+        loadOnomatopoeia.push_back(localData);
+        loadOnomatopoeiaCoordinate.push_back(localPolygon);
+    }
+}
+
+void ComicMetadata::XMLPurse_Item(QXmlStreamReader &reader)
+{
+//    std::cout << "purse item" << std::endl;
+    if(!isTag(reader, "ItemData")){
+        reader.skipCurrentElement();
+        return;
+    }
+    while(reader.readNextStartElement()){
+        if(!isTag(reader, "Item")){
+            reader.skipCurrentElement();
+            continue;
+        }
+        ItemData localData;
+        QPolygonF localPolygon;
+        while(reader.readNextStartElement()){
+            if(isTag(reader, "Class")){
+                localData.itemClass = readFirstText(reader);
+            }
+            else if(isTag(reader, "Description")){
+                localData.description = readFirstText(reader);
+            }
+            else if(isTag(reader, "Frame")){
+                localData.targetFrame = readNonNegativeInt(reader);
+            }
+            else if(isTag(reader, "Coordinate")){
+                localPolygon = XMLPurse_Coordinate(reader);
+            }
+            else{
+                reader.skipCurrentElement();
+            }
+        }
+        loadItem.push_back(localData);
+        loadItemCoordinate.push_back(localPolygon);
+    }
+}
+
+
+
+void ComicMetadata::clearCharacterName()
+{
+    characterName.clear();
+    characterName.push_back(UnDefinedCharacterName);
+}
+
+
+
+
+
+
+
+
+
+
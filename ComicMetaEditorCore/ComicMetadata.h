@@ -0,0 +1,333 @@
+﻿/*! \file
+ *  \brief マンガメタデータ用クラス群
+ *  \author Daisuke
+ *  \date 2016/03/ daisuke コメント追加
+ */
+
+#ifndef COMICMETADATA_H
+#define COMICMETADATA_H
+#include "GraphicsItemData.h"
+#include "StableIdIndex.h"
+
+#include <QVector>
+#include <QString>
+#include <QTextDocument>
+#include <QtCore>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+/*!
+ * \brief メタデータの種類定義用enum
+ */
+enum ComicMetadataType{
+    ComicMetadata_Frame,
+    ComicMetadata_Character,
+    ComicMetadata_Dialog,
+    ComicMetadata_Onomatopoeia,
+    ComicMetadata_Item,
+    ComicMetadata_All
+};
+
+/*!
+ * \brief メタデータの変更箇所記録用フラグ
+ */
+enum ComicMetadataChange{
+    ComicMetadataChange_None = 0x00,
+    ComicMetadataChange_Common = 0x01, //!<作品名、登場人物リスト
+    ComicMetadataChange_PageInfo = 0x02, //!<話数、ページ番号等のページ情報
+    ComicMetadataChange_Frame = 0x04,
+    ComicMetadataChange_Character = 0x08,
+    ComicMetadataChange_Dialog = 0x10,
+    ComicMetadataChange_Onomatopoeia = 0x20,
+    ComicMetadataChange_Item = 0x40,
+    ComicMetadataChange_Page = 0x7e, //!<ページメタデータ全体
+    ComicMetadataChange_All = 0x7f
+};
+
+/*!
+ * \brief コマ用メタデータクラス
+ */
+class FrameData
+{
+public:
+    FrameData();
+    bool sceneBoundary;//!<シーンの切り替えフラグ
+    GraphicsItemData GIData;//!<画面上に表示する枠の情報(Qt)
+};
+
+/*!
+  * \brief 登場人物用メタデータクラス
+  */
+ class CharacterData
+{
+public:
+    CharacterData();
+    QString characterName;
+    int characterID;//!<登場人物ID
+    int targetFrame;//!<対象とするコマの番号（1から）、ターゲットとするコマ無しの場合には0。コマの削除・並べ替え時はComicMetadataが更新する
+    GraphicsItemData GIData;//!<画面上に表示する枠の情報(Qt)
+};
+
+/*!
+ * \brief セリフ用メタデータクラス
+ */
+class DialogData
+{
+public:
+    DialogData();
+    QString text;
+    int fontSize;//!<フォントサイズを5段階で定義 1:very small, 2:small 3:normal 4:large 5:very large
+    bool narration;//!<ナレーションの場合にはtrueとする
+    int targetCharacterID;//!<ナレーション以外の場合には対応する登場人物IDを保持する
+    QString characterName;//!<要修正　targetCharacterIDから自動取得できる様にする必要が有る
+    //!<話者の選択（キャラクターメタデータ(どのシーンの誰なのか？)話者を並べ替えた際には必ず更新する事
+    int targetFrame;//!<対象とするコマの番号（1から）、ターゲットとするコマ無しの場合には0。コマの削除・並べ替え時はComicMetadataが更新する
+    GraphicsItemData GIData;//!<画面上に表示する枠の情報(Qt)
+};
+
+/*!
+ * \brief オノマトペ用メタデータクラス
+ */
+class OnomatopoeiaData
+{
+public:
+    OnomatopoeiaData();
+    void setText(QString str);
+    QString text;//!<読み情報
+    int fontSize;//!<1:very small, 2:small 3:normal 4:large 5:very large
+    int targetFrame;//!<対象とするコマの番号（1から）、ターゲットとするコマ無しの場合には0。コマの削除・並べ替え時はComicMetadataが更新する
+    GraphicsItemData GIData;//!<画面上に表示する枠の情報(Qt)
+};
+
+/*!
+ * \brief The ItemData class
+ * 物等記述用メタデータクラス
+ */
+class ItemData
+{
+public:
+    ItemData();
+    QString itemClass;
+    QString description;//!<記述された内容
+    int targetFrame;//!<対象とするコマの番号（1から）、ターゲットとするコマ無しの場合には0。コマの削除・並べ替え時はComicMetadataが更新する
+    GraphicsItemData GIData;//!<画面上に表示する枠の情報(Qt)
+};
+
+/*!
+ * \brief 1ページに対応するメタデータ保持用クラス
+ * 上記各メタデータクラスの保持とその取扱いを行う
+ */
+class ComicMetadata{
+public:
+    int indent;
+    ComicMetadata(); //!<コンストラクタ
+    QString workTitle; //!<作品名
+    int episodeNumber; //!<話数
+    int pageNumber; //!<ページ番号
+    QString imageFileName; //!<画像ファイル名
+    int imageWidth; //!<画像の幅
+    int imageHeight; //!<画像の高さ
+    QVector<QString> characterName; //!<キャラクター名リスト
+    QSharedPointer<QVector<FrameData> > frame; //!<コマリスト
+    QSharedPointer<QVector<CharacterData> > character; //!<キャラクターリスト
+    QSharedPointer<QVector<DialogData> > dialog; //!<セリフリスト
+    QSharedPointer<QVector<OnomatopoeiaData> > onomatopoeia; //!<オノマトペリスト
+    QSharedPointer<QVector<ItemData> > item; //!<その他のアイテムリスト
+
+    /*!
+     * \brief 各リストの中身まで複製したメタデータを返す
+     * バックグラウンドでの保存用。複製側の表示用アイテムへのポインタはNULLとする
+     * \return 複製したメタデータ
+     */
+    QSharedPointer<ComicMetadata> clone() const;
+
+    /*!
+     * \brief 指定したタイプの枠情報取得用関数
+     * \param type メタデータの種類
+     * \return
+     */
+    QVector<GraphicsItemData> getGraphicsItemList(ComicMetadataType type);
+
+    /*!
+     * \brief 複数ページ共通のメタデータ（書籍情報、登場人物リスト）を読み込む関数
+     * \param fileName メタデータファイル名
+     * \return
+     */
+    bool loadMetadata_Common(QString fileName);
+    bool loadMetadata_Common(QIODevice *device);//!<読み込み元を直接指定する場合
+
+    /*!
+     * \brief 複数ページ共通のメタデータを出力する関数
+     * \param fileName 出力先メタデータファイル名
+     * \return
+     */
+    bool writeMetadata_Common(QString fileName);
+    bool writeMetadata_Common(QIODevice *device);//!<出力先を直接指定する場合
+
+    /*!
+     * @brief ページメタデータ読み込み用関数
+     * @param fileName ファイル名
+     * @param targetPageNumber 直接読み込むページを指定する場合使う -1ならば指定なし
+     * @return 読み込みの成否
+     * 読み込み時は一度loadエリアにストアしておき後にMainWindowからloadエリアの各データを実際のメタデータとして生成する
+     * ->画像サイズがセットされていない為
+     */
+    bool loadMetadata_Page(QString fileName, int targetPageNumber = -1);
+    bool loadMetadata_Page(QIODevice *device, int targetPageNumber = -1);//!<読み込み元を直接指定する場合
+
+    /*!
+     * \brief ページメタデータ出力用関数
+     * \param fileName 出力先メタデータファイル名
+     * \return
+     */
+    bool writeMetadata_Page(QString fileName);
+    bool writeMetadata_Page(QIODevice *device);//!<出力先を直接指定する場合
+
+    /*!
+     * \brief タイプと番号で指定されたメタデータをリストから削除する
+     * コマを削除した場合は、各注釈の対象コマ（targetFrame）も削除後の番号に更新する
+     * （削除したコマを対象としていた場合は対象コマ無しとなる）
+     * \param target メタデータの種類
+     * \param number メタデータの番号
+     */
+    void deleteItem(ComicMetadataType target, int number);
+
+    /*!
+     * \brief 指定したメタデータの固定IDを取得する
+     * IDは削除・並べ替えを行っても変わらないため、番号の代わりに保持しておく事ができる
+     * \param type メタデータの種類
+     * \param number メタデータの番号
+     * \return ID（範囲外の場合0）
+     */
+    quint32 itemId(ComicMetadataType type, int number) const;
+    int itemNumber(ComicMetadataType type, quint32 id) const;//!<固定IDから現在の番号を求める（無い場合-1）
+
+    /*!
+     * \brief 指定したタイプのメタデータを並べ替える
+     * コマを並べ替えた場合は、各注釈の対象コマ（targetFrame）も並べ替え後の番号に更新する
+     * \param type メタデータの種類
+     * \param order 並べ替え後のi番目の要素の、並べ替え前の番号（全ての番号を1回ずつ含む事）
+     * \return 並べ替えた場合true
+     */
+    bool reorderItems(ComicMetadataType type, const QVector<int> &order);
+
+    /*!
+     * \brief 指定した番号のコマを直接編集するための参照を返す
+     * レコード全体を複製して置き換えずに1項目だけを書き換える場合に使う。
+     * 呼び出した時点でコマのリストが変更されたことを記録する\n
+     * 番号が範囲内である事は呼び出し側で確認する事。
+     * 参照はリストへの追加・削除を行うまでの間のみ有効
+     * \param number コマの番号
+     * \return コマのメタデータへの参照
+     */
+    FrameData &editFrame(int number);
+    CharacterData &editCharacter(int number);//!<登場人物を直接編集する（editFrameと同様）
+    DialogData &editDialog(int number);//!<セリフを直接編集する（editFrameと同様）
+    OnomatopoeiaData &editOnomatopoeia(int number);//!<オノマトペを直接編集する（editFrameと同様）
+    ItemData &editItem(int number);//!<アイテムを直接編集する（editFrameと同様）
+
+    /*!
+     * \brief 現在保持しているCommonメタデータと、ページメタデータをすべて消去する
+     */
+    void clear();
+
+    /*!
+     * \brief 現在保持しているCommonメタデータを消去する
+     */
+    void clearCommon();
+
+    /*!
+     * \brief 現在保持しているページメタデータを消去する
+     */
+    void clearPageMetadata();
+
+    /*!
+     * \brief キャラクター情報を全消去する
+     */
+    void clearCharacterName();
+
+
+    /*!
+     * \brief 指定したタイプのメタデータリストが変更されたことを記録する
+     * \param type メタデータの種類（ComicMetadata_Allの場合はページメタデータ全体）
+     */
+    void markChanged(ComicMetadataType type);
+    void markCommonChanged();//!<作品名、登場人物リストが変更されたことを記録する
+    void markPageInfoChanged();//!<話数、ページ番号等が変更されたことを記録する
+    int changedFlags() const;//!<変更箇所のフラグ(ComicMetadataChangeの組み合わせ)
+    bool isChanged() const;//!<前回の保存・読み込み以降に変更が有るかどうか
+    bool isCommonChanged() const;//!<共通メタデータに変更が有るかどうか
+    bool isPageChanged() const;//!<ページメタデータに変更が有るかどうか
+
+    /*!
+     * \brief 変更の記録を消去し、現在の内容を保存済みの内容として記憶する
+     * メタデータの読み込み後、保存後に呼び出す
+     */
+    void clearChanged();
+
+    /*!
+     * \brief 変更が記録された箇所のうち、内容が保存済みの内容と同じものの記録を消去する
+     * UIの再表示等により、値を変えずに書き戻された場合の変更記録を取り除くために使う
+     */
+    void dropUnchangedFlags();
+
+    /*!
+     * \brief 指定したメタデータのマンガパス式を、現在の作品名・話数・ページ番号・対象コマ・番号から求める
+     * マンガパス式は保持せず必要な時（表示、保存時）にこの関数で求める
+     * \param type メタデータの種類
+     * \param number メタデータの番号
+     * \return マンガパス式（範囲外の場合は空文字列）
+     */
+    QString mangaPath(ComicMetadataType type, int number) const;
+
+    //マンガパス式を得る関数
+    QString MangaPath_title_episode() const;//!<マンガパス式を取得するための関数
+    QString MangaPath_page() const;//!<マンガパス式を取得するための関数
+    QString MangaPath_frame(int number) const;//!<マンガパス式を取得するための関数
+    QString MangaPath_title_episode_page_frame(int frameNumber) const;//!<マンガパス式を取得するための関数
+
+    //以下はXML生成時に利用する関数
+    void XMLCreate_Coordinage(QXmlStreamWriter &writer, const GraphicsItemData &GIData);//!<XML生成用
+    void XMLCreate_Frame(QXmlStreamWriter &writer);//!<XML生成用
+    void XMLCreate_Character(QXmlStreamWriter &writer);//!<XML生成用
+    void XMLCreate_Dialog(QXmlStreamWriter &writer);//!<XML生成用
+    void XMLCreate_Onomatopoeia(QXmlStreamWriter &writer);//!<XML生成用
+    void XMLCreate_Item(QXmlStreamWriter &writer);//!<XML生成用
+
+    //以下はXML読み込み時に利用する関数
+    //各要素の開始タグの位置にあるリーダーを受け取り、対応する終了タグまで読み進める
+    void XMLPurse_CharacterList(QXmlStreamReader &reader);//!<XML読み込み用
+    void XMLPurse_Frame(QXmlStreamReader &reader);//!<XML読み込み用
+    void XMLPurse_Character(QXmlStreamReader &reader);//!<XML読み込み用
+    void XMLPurse_Dialog(QXmlStreamReader &reader);//!<XML読み込み用
+    void XMLPurse_Onomatopoeia(QXmlStreamReader &reader);//!<XML読み込み用
+    void XMLPurse_Item(QXmlStreamReader &reader);//!<XML読み込み用
+    QPolygonF XMLPurse_Coordinate(QXmlStreamReader &reader);//!<XML読み込み用
+    void clearLoadArea();//!<読み込んだデータの保持場所を初期化する
+
+    //以下は読み込まれたデータの保持場所
+    int loadEpisodeNumber;//!<読み込んだデータ用
+    int loadPageNumber;//!<読み込んだデータ用
+    QString loadImageFileName;//!<読み込んだデータ用
+    QVector<FrameData> loadFrame;//!<読み込んだデータ用
+    QVector<QPolygonF> loadFrameCoordinate;//!<読み込んだデータ用
+    QVector<CharacterData> loadCharacter;//!<読み込んだデータ用
+    QVector<QPolygonF> loadCharacterCoordinate;//!<読み込んだデータ用
+    QVector<DialogData> loadDialog;//!<読み込んだデータ用
+    QVector<QPolygonF> loadDialogCoordinate;//!<読み込んだデータ用
+    QVector<OnomatopoeiaData> loadOnomatopoeia;//!<読み込んだデータ用
+    QVector<QPolygonF> loadOnomatopoeiaCoordinate;//!<読み込んだデータ用
+    QVector<ItemData> loadItem;//!<読み込んだデータ用
+    QVector<QPolygonF> loadItemCoordinate;//!<読み込んだデータ用
+
+private:
+    QByteArray fingerprint(ComicMetadataChange section) const;//!<指定箇所の内容のハッシュ値
+    int itemCount(ComicMetadataType type) const;//!<指定したタイプのリストの要素数
+    StableIdIndex &idIndex(ComicMetadataType type) const;//!<リストに追加された要素へIDを割り当ててから索引を返す
+    QVector<quint32> frameIds() const;//!<全てのコマのID（番号順）
+    void updateTargetFrame(const QVector<quint32> &previousFrameIds);//!<コマの削除・並べ替え後に各注釈の対象コマを更新する
+    mutable StableIdIndex _ids[ComicMetadata_All];//!<各リストの固定ID
+    int _changed;//!<変更箇所のフラグ
+    QHash<int, QByteArray> _savedFingerprint;//!<保存済みの内容のハッシュ値
+};
+#endif // COMICMETADATA_H
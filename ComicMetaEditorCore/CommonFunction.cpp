@@ -0,0 +1,153 @@
+﻿/*!
+ * \file
+ */
+#include "CommonFunction.h"
+#include <cmath>
+#include <QVarLengthArray>
+
+/*!
+ * \brief 線分abと点pとの距離を計算する
+ * 参考：http://katahiromz.web.fc2.com/c/lineseg.html \n
+ * 線分上の最近点の位置tを[0,1]に切り詰める事で、端点が最近点となる場合も分岐なしで計算する
+ */
+static inline double segmentDistance(double ax, double ay, double bx, double by, double px, double py)
+{
+    double abx = bx - ax;
+    double aby = by - ay;
+    double apx = px - ax;
+    double apy = py - ay;
+    double r2 = abx * abx + aby * aby;
+    //! 線分の長さが0だった場合は端点aとの距離になる
+    double t = r2 > 0 ? (abx * apx + aby * apy) / r2 : 0.0;
+    t = t < 0 ? 0.0 : (t > 1 ? 1.0 : t);
+    double dx = apx - t * abx;
+    double dy = apy - t * aby;
+    return sqrt(dx * dx + dy * dy);
+}
+
+double calcPolygonAreaSize(const QPolygonF &polygon)
+{
+    return calcPolygonAreaSize(polygon.constData(), polygon.size());
+}
+
+double getDistance(const QLineF &line, const QPointF &pt)
+{
+    //! 線分lineと点ptとの距離Lを求める
+    return segmentDistance(line.x1(), line.y1(), line.x2(), line.y2(), pt.x(), pt.y());
+}
+
+double calcDistance(const QPointF &pt1, const QPointF &pt2){
+    double dx = pt2.x() - pt1.x();
+    double dy = pt2.y() - pt1.y();
+    return sqrt(dx * dx + dy * dy);
+}
+
+double calcPolygonAreaSize(const QPointF *points, int count)
+{
+    if(count < 3) return 0.0;
+
+    //! 隣り合う頂点の外積の和を求める（シューレース公式）
+    //! 加算の依存関係を断つため4つの部分和に分けて計算する
+    //! （各項は隣り合う頂点のx,yを組み合わせるため、SIMD化ではなく加算の待ち時間を重ねる事が目的）
+    double sum0 = 0.0, sum1 = 0.0, sum2 = 0.0, sum3 = 0.0;
+    int last = count - 1;
+    int i = 0;
+    for(; i + 4 <= last; i += 4){
+        sum0 += points[i].x() * points[i+1].y() - points[i+1].x() * points[i].y();
+        sum1 += points[i+1].x() * points[i+2].y() - points[i+2].x() * points[i+1].y();
+        sum2 += points[i+2].x() * points[i+3].y() - points[i+3].x() * points[i+2].y();
+        sum3 += points[i+3].x() * points[i+4].y() - points[i+4].x() * points[i+3].y();
+    }
+    for(; i < last; i++){
+        sum0 += points[i].x() * points[i+1].y() - points[i+1].x() * points[i].y();
+    }
+    //! 最後の頂点から最初の頂点への辺
+    sum0 += points[last].x() * points[0].y() - points[0].x() * points[last].y();
+    return fabs((sum0 + sum1) + (sum2 + sum3)) / 2;
+}
+
+void calcPolygonAreaSizes(const QPointF *points, const int *offsets, int polygonCount, double *areaSizes)
+{
+    for(int i=0; i<polygonCount; i++){
+        areaSizes[i] = calcPolygonAreaSize(points + offsets[i], offsets[i+1] - offsets[i]);
+    }
+}
+
+void calcEdgeDistances(const QPointF *points, int count, const QPointF &pt, double *distances)
+{
+    if(count <= 0) return;
+    double px = pt.x();
+    double py = pt.y();
+    int last = count - 1;
+    for(int i=0; i<last; i++){
+        distances[i] = segmentDistance(points[i].x(), points[i].y(), points[i+1].x(), points[i+1].y(), px, py);
+    }
+    //! 最後の頂点から最初の頂点への辺
+    distances[last] = segmentDistance(points[last].x(), points[last].y(), points[0].x(), points[0].y(), px, py);
+}
+
+int findNearestEdge(const QPointF *points, int count, const QPointF &pt, double *distance)
+{
+    if(count <= 0) return -1;
+    QVarLengthArray<double, 64> distances(count);
+    calcEdgeDistances(points, count, pt, distances.data());
+    int nearest = 0;
+    for(int i=1; i<count; i++){
+        if(distances[i] < distances[nearest]) nearest = i;
+    }
+    if(distance) *distance = distances[nearest];
+    return nearest;
+}
+
+int findNearestPoint(const QPointF *points, int count, const QPointF &pt, double *distance)
+{
+    if(count <= 0) return -1;
+    double px = pt.x();
+    double py = pt.y();
+
+    //! 距離の2乗を一括で計算してから最小のものを探す（平方根は最後に1回だけ計算する）
+    QVarLengthArray<double, 64> squared(count);
+    for(int i=0; i<count; i++){
+        double dx = points[i].x() - px;
+        double dy = points[i].y() - py;
+        squared[i] = dx * dx + dy * dy;
+    }
+    int nearest = 0;
+    for(int i=1; i<count; i++){
+        if(squared[i] < squared[nearest]) nearest = i;
+    }
+    if(distance) *distance = sqrt(squared[nearest]);
+    return nearest;
+}
+
+QPointF getPolygonCenter(const QPointF *points, int count)
+{
+    if(count <= 0) return QPointF();
+    double x = 0.0;
+    double y = 0.0;
+    for(int i=0; i<count; i++){
+        x += points[i].x();
+        y += points[i].y();
+    }
+    return QPointF(x / count, y / count);
+}
+
+double crossVector(QPointF vl, QPointF vr){
+    return vl.x() * vr.y() - vl.y() * vr.x();
+}
+
+
+QRectF getRectBy2Pt(QPoint pt1, QPoint pt2)
+{
+    int ltx = std::min(pt1.x(), pt2.x());
+    int width = fabs((double)pt1.x()-(double)pt2.x());
+    int lty = std::min(pt1.y(), pt2.y());
+    int height = fabs((double)pt1.y()-(double)pt2.y());
+    QRectF rect(ltx,lty,width,height);
+    return rect;
+}
+
+QPointF getPolygonCenter(const QPolygonF &polygon)
+{
+    return getPolygonCenter(polygon.constData(), polygon.size());
+}
@@ -0,0 +1,120 @@
+﻿/*! \file
+ *  \brief 各種座標計算系実装部
+ *  \author Daisuke
+ *  \date 2016/03/ daisuke コメント追加
+ */
+
+#ifndef COMMONFUNCTION_H
+#define COMMONFUNCTION_H
+#include <QPolygonF>
+#include <QLineF>
+#include <QRectF>
+
+/*!
+ * \brief ポリゴンの面積を計算する関数
+ * \param ポリゴン（頂点情報）
+ * \return
+ */
+double calcPolygonAreaSize(const QPolygonF &polygon);
+/*!
+ * \brief 点と直線との距離を計算する関数
+ * \param 基準となる直線
+ * \param 点
+ * \return
+ */
+double getDistance(const QLineF &line, const QPointF &pt);
+
+/*!
+ * \brief 2点間の距離計算関数
+ * \param 点1
+ * \param 点2
+ * \return
+ */
+double calcDistance(const QPointF &pt1, const QPointF &pt2);
+
+/*
+ * 以下は連続した座標配列（QPolygonF::constData()等）に対して一括で計算する関数。
+ * QPolygonFの要素アクセスや1要素毎の関数呼び出しを省く事を目的としている。
+ * 座標はx,yが交互に並んだ配列のままであるため、コンパイラによるSIMD化は前提としない
+ */
+
+/*!
+ * \brief 座標配列で表されたポリゴンの面積を計算する関数
+ * \param points 頂点の配列
+ * \param count 頂点数
+ * \return 面積（頂点数が3未満の場合0）
+ */
+double calcPolygonAreaSize(const QPointF *points, int count);
+
+/*!
+ * \brief 複数のポリゴンの面積を一括で計算する関数
+ * i番目のポリゴンの頂点はpoints[offsets[i]]からpoints[offsets[i+1]-1]までとする
+ * \param points 全ポリゴンの頂点を連結した配列
+ * \param offsets 各ポリゴンの先頭位置（要素数はpolygonCount+1）
+ * \param polygonCount ポリゴン数
+ * \param areaSizes 面積の格納先（要素数はpolygonCount）
+ */
+void calcPolygonAreaSizes(const QPointF *points, const int *offsets, int polygonCount, double *areaSizes);
+
+/*!
+ * \brief 点とポリゴンの各辺（線分）との距離を一括で計算する関数
+ * i番目の辺はpoints[i]からpoints[(i+1)%count]までとする
+ * \param points 頂点の配列
+ * \param count 頂点数（辺の数と同じ）
+ * \param pt 点
+ * \param distances 距離の格納先（要素数はcount）
+ */
+void calcEdgeDistances(const QPointF *points, int count, const QPointF &pt, double *distances);
+
+/*!
+ * \brief 点から最も近い辺を検索する関数
+ * \param points 頂点の配列
+ * \param count 頂点数（辺の数と同じ）
+ * \param pt 点
+ * \param distance 最も近い辺との距離の格納先（NULL可）
+ * \return 辺の番号（頂点が無い場合-1）
+ */
+int findNearestEdge(const QPointF *points, int count, const QPointF &pt, double *distance = 0);
+
+/*!
+ * \brief 点から最も近い頂点を検索する関数
+ * \param points 頂点の配列
+ * \param count 頂点数
+ * \param pt 点
+ * \param distance 最も近い頂点との距離の格納先（NULL可）
+ * \return 頂点の番号（頂点が無い場合-1）
+ */
+int findNearestPoint(const QPointF *points, int count, const QPointF &pt, double *distance = 0);
+
+/*!
+ * \brief 座標配列で表されたポリゴンの中心座標（頂点の平均）を計算する関数
+ * \param points 頂点の配列
+ * \param count 頂点数
+ * \return 中心座標（頂点が無い場合(0,0)）
+ */
+QPointF getPolygonCenter(const QPointF *points, int count);
+
+/*!
+ * \brief (0,0)を基準とした2つのベクトルの内積計算関数
+ * \param ベクトル1（点）
+ * \param ベクトル2（点）
+ * \return
+ */
+double crossVector(QPointF vl, QPointF vr);
+
+/*!
+ * \brief 2点の情報をQtのQRectF形式に変換する関数
+ * \param 点1
+ * \param 点2
+ * \return
+ */
+QRectF getRectBy2Pt(QPoint pt1, QPoint pt2);
+
+/*!
+ * \brief 渡されたポリゴンの中心座標を計算する関数
+ * \param ポリゴン（頂点情報）
+ * \return
+ */
+QPointF getPolygonCenter(const QPolygonF &polygon);
+
+#endif // COMMONFUNCTION_H
@@ -0,0 +1,184 @@
+﻿/*!
+ * \file
+ */
+#include "FileUtility.h"
+
+using namespace std;
+namespace IL{
+
+FileUtility::FileUtility()
+{
+#ifdef P_CONSTRUCT
+    cout << "P_CONSTRUCT > FileUtility::FileUtility()" << endl;
+#endif
+    _currentFileNumber = 0;
+    connect(&_watcher, SIGNAL(directoryChanged(QString)),
+            this, SLOT(Sl_directoryChanged(QString)));
+}
+
+FileUtility::~FileUtility()
+{
+#ifdef P_DESTRUCT
+    cout << "P_DESTRUCT  > FileUtility::~FileUtility()" << endl;
+#endif
+}
+
+void FileUtility::setSuffixFilter(QStringList fileSuffixFilter)
+{
+    _fileSuffixFilter = fileSuffixFilter;
+    //!次回のsetFileでファイルリストを読み直す
+    _directoryPath.clear();
+}
+
+bool FileUtility::setFile(QString fileName)
+{
+    QFileInfo fileInfo(fileName);
+
+    if(_fileSuffixFilter.isEmpty()){
+        QString suffix = "*.";
+        suffix += fileInfo.suffix();
+        _fileSuffixFilter.push_back(suffix);
+        _directoryPath.clear();
+    }
+
+    //!ディレクトリが切り替わった場合、またはファイルが一覧にない（追加された）場合のみファイルリストを読み直す
+    QString directoryPath = fileInfo.absolutePath();
+    QString absoluteFilePath = fileInfo.absoluteFilePath();
+    bool refreshed = false;
+    if(directoryPath != _directoryPath || !_indexOfPath.contains(absoluteFilePath)){
+        refreshFileList(directoryPath);
+        refreshed = true;
+    }
+
+    //!読み直した一覧にもない場合は失敗とする（現在の番号は一覧の範囲内に収める）
+    bool found = _indexOfPath.contains(absoluteFilePath);
+    if(found){
+        _currentFileNumber = _indexOfPath.value(absoluteFilePath);
+    }
+    else if((int)_currentFileNumber >= _fileInfoList.size()){
+        _currentFileNumber = 0;
+    }
+
+    //!現在の番号を確定してから一覧の変更を通知する
+    if(refreshed) emit signal_fileListChanged();
+#ifdef P_FILEUTILITY
+    std::cout << "P_FILEUTILITY >> FileUtility::setFile FileName = "
+              << fileName.toStdString() << endl;
+    std::cout << "P_FILEUTILITY >> FileUtility::setFile CurrentFileNumber = "
+              <<_currentFileNumber << endl;
+#endif
+    return found;
+}
+
+void FileUtility::refreshFileList(QString directoryPath)
+{
+    if(directoryPath != _directoryPath){
+        if(!_watcher.directories().isEmpty()){
+            _watcher.removePaths(_watcher.directories());
+        }
+        _watcher.addPath(directoryPath);
+        _directoryPath = directoryPath;
+    }
+
+    QDir directory(directoryPath);
+    directory.setNameFilters(_fileSuffixFilter);
+    _fileInfoList = directory.entryInfoList(QDir::Files);
+    _indexOfPath.clear();
+    _indexOfPath.reserve(_fileInfoList.size());
+    for(int i=0; i<_fileInfoList.size(); i++){
+#ifdef P_FILEUTILITY_DEBUG
+        cout << _fileInfoList.at(i).absoluteFilePath().toStdString() << endl;
+#endif
+        _indexOfPath.insert(_fileInfoList.at(i).absoluteFilePath(), i);
+    }
+}
+
+void FileUtility::Sl_directoryChanged(const QString &path)
+{
+    Q_UNUSED(path);
+    if(_directoryPath.isEmpty()) return;
+
+    //!現在のファイルの位置を保ったままファイルリストを読み直す
+    QString currentFileName = getCurrentFileName();
+    int currentFileNumber = _currentFileNumber;
+    refreshFileList(_directoryPath);
+    if(_indexOfPath.contains(currentFileName)){
+        _currentFileNumber = _indexOfPath.value(currentFileName);
+    }
+    else if(_fileInfoList.isEmpty() || currentFileNumber < _fileInfoList.size()){
+        _currentFileNumber = currentFileNumber;
+    }
+    else{
+        _currentFileNumber = _fileInfoList.size() - 1;
+    }
+    emit signal_fileListChanged();
+#ifdef P_FILEUTILITY
+    std::cout << "P_FILEUTILITY >> FileUtility::Sl_directoryChanged " << path.toStdString() << endl;
+#endif
+}
+
+int FileUtility::size() const
+{
+    return _fileInfoList.size();
+}
+
+int FileUtility::getCurrentNumber() const
+{
+    if(_fileInfoList.isEmpty()) return -1;
+    return _currentFileNumber;
+}
+
+QString FileUtility::getCurrentFileName() const
+{
+    if(_fileInfoList.isEmpty()) return "";
+
+    return _fileInfoList.at(_currentFileNumber).absoluteFilePath();
+}
+
+QString FileUtility::getCurrentFileNameCore() const
+{
+    QFileInfo info(getCurrentFileName());
+    return info.fileName();
+}
+
+QString FileUtility::getCurrentFileNameCore_WOExt() const
+{
+    QFileInfo info(getCurrentFileName());
+    return info.baseName();
+}
+
+QString FileUtility::getNextFileName() const
+{
+    if(_fileInfoList.isEmpty()) return "";
+    int next = _currentFileNumber + 1;
+    if(next >= _fileInfoList.size()){
+        next = 0;
+    }
+    return _fileInfoList.at(next).absoluteFilePath();
+}
+
+QString FileUtility::getPreviousFileName() const
+{
+    int previous;
+    if(_fileInfoList.isEmpty()){
+        return "";
+    }
+
+    if(0 < _currentFileNumber){
+        previous = _currentFileNumber - 1;
+    }
+    else{
+        previous = _fileInfoList.size() - 1;
+    }
+    return _fileInfoList.at(previous).absoluteFilePath();
+}
+
+QString FileUtility::getFileName(int number) const
+{
+    if(_fileInfoList.isEmpty() || number >= _fileInfoList.size() || number < 0){
+        return "";
+    }
+    return _fileInfoList.at(number).absoluteFilePath();
+}
+
+} // namespace IL
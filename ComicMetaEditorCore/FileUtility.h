@@ -20,8 +20,9 @@
 #include <QFileInfoList>
 #include <QStringList>
 #include <iostream>
-#include <QWidget>
-#include <QFileDialog>
+#include <QObject>
+#include <QHash>
+#include <QFileSystemWatcher>
 
 namespace IL{
 
@@ -31,10 +32,13 @@ namespace IL{
 /*!
  * \brief 前後のファイルに移動可能となる機能付きファイル名管理クラス
  * 利用の際には本体プログラムでファイルを読み込むごとに、setFile(QString fileName)にて
- * 現在のファイル名をセットする事
+ * 現在のファイル名をセットする事\n
+ * ディレクトリ内のファイル一覧はキャッシュしておき、ディレクトリが切り替わった場合と
+ * QFileSystemWatcherによりディレクトリの変更が通知された場合にのみ読み直す
  */
-class FileUtility
+class FileUtility : public QObject
 {
+    Q_OBJECT
 public:
     FileUtility();//!< コンストラクタ
     ~FileUtility();//!< デストラクタ
@@ -48,9 +52,11 @@ public:
 
     /*!
      * \brief setFileにファイル名を入れることで、本クラス内で当該ディレクトリ内のファイル群を扱えるようになる
+     * ファイルがキャッシュ済みの一覧にない場合は一覧を読み直してから探す
      * \param fileName ファイル名
+     * \return 読み直した一覧にもファイルが見つからなかった場合false（現在のファイルは変更しない）
      */
-    void setFile(QString fileName);//
+    bool setFile(QString fileName);//
 
     /*!
      * \brief setFileで与えられたファイルが含まれるフォルダにある、取り扱う拡張子のファイル数を得る
@@ -101,10 +107,21 @@ public:
      */
     QString getFileName(int number) const;
 
+signals:
+    //! ファイル一覧が読み直された場合に通知する
+    void signal_fileListChanged();
+
+private slots:
+    void Sl_directoryChanged(const QString &path);
+
 private:
+    void refreshFileList(QString directoryPath);
     QStringList _fileSuffixFilter; //!<ファイルリストの置き場所
     unsigned int _currentFileNumber; //!<現在のファイルの順番
     QFileInfoList _fileInfoList; //!<ディレクトリ内のファイルリスト
+    QString _directoryPath; //!<ファイルリストを読み込んだディレクトリの絶対パス
+    QHash<QString, int> _indexOfPath; //!<ファイルの絶対パスからファイルリスト内の順番への対応
+    QFileSystemWatcher _watcher; //!<ディレクトリの変更監視用
 };
 
 }
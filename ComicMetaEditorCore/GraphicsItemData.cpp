@@ -3,6 +3,14 @@
  */
 
 #include "GraphicsItemData.h"
+#include "CommonFunction.h"
+
+static GraphicsPolygonViewFactory graphicsPolygonViewFactory = NULL;
+
+void setGraphicsPolygonViewFactory(GraphicsPolygonViewFactory factory)
+{
+    graphicsPolygonViewFactory = factory;
+}
 
 GraphicsItemColor::GraphicsItemColor()
 {
@@ -125,12 +133,13 @@ void GraphicsItemColor::setColorPreset(GraphicsItemDataColor colType)
 
 /*!
  * \brief 引数なしのコンストラクタでは（赤がせっとされる）
- * コンストラクタにてQGraqphicsPolygonItemの実体をnewする
+ * コンストラクタにて表示用アイテムの実体を生成関数でnewする
  */
 GraphicsItemData::GraphicsItemData()
 {
     _item = NULL;
-    _item = new QGraphicsPolygonItem();
+    _areaSize = 0.0;
+    if(graphicsPolygonViewFactory) _item = graphicsPolygonViewFactory();
     setColorPreset(GraphicsItemDataColor_Red);
 }
 
@@ -141,31 +150,34 @@ GraphicsItemData::GraphicsItemData()
 GraphicsItemData::GraphicsItemData(GraphicsItemDataColor color)
 {
     _item = NULL;
-    _item = new QGraphicsPolygonItem();
+    _areaSize = 0.0;
+    if(graphicsPolygonViewFactory) _item = graphicsPolygonViewFactory();
     setColorPreset(color);
 }
 
 /*!
- * \brief QGraphicsPolygonItem付きで生成される場合にはそのアイテムを使用する
+ * \brief 表示用アイテム付きで生成される場合にはそのアイテムを使用する
  * \param item
  */
-void GraphicsItemData::setGraphicsPolygonItem(QGraphicsPolygonItem* item)
+void GraphicsItemData::setGraphicsPolygonItem(GraphicsPolygonView* item)
 {
     _item = item;
 }
 
 /*!
- * \brief 渡されたポリゴンを、クラスで保持しているQGraphicsPolygonItemに反映する
+ * \brief 渡されたポリゴンを、クラスで保持している表示用アイテムに反映する
+ * 表示用アイテムが無い場合も相対座標は計算する
  * \param polygon 画像上の座標列
  * \param width 画像幅
  * \param height 画像高さ
  */
 void GraphicsItemData::setPolygon(QPolygonF &polygon, int width, int height)
 {
-    if(_item == NULL) return;
-    _item->setPolygon(polygon);
     //!画像に対する相対座標を計算
     _relativePosition = calcRelativePosition(polygon, width, height);
+    updateGeometry(polygon);
+    if(_item == NULL) return;
+    _item->setPolygon(polygon);
 }
 
 /*!
@@ -176,13 +188,46 @@ void GraphicsItemData::setPolygon(QPolygonF &polygon, int width, int height)
  */
 void GraphicsItemData::setRelativePolygon(QPolygonF &polygon, int width, int height)
 {
-    if(_item == NULL) return;
     _relativePosition = polygon;
     //!相対表現の座標列を絶対座標の座標列に変換してセットする
-    _item->setPolygon(calcAbsolutePosition(polygon, width, height));
+    updateGeometry(calcAbsolutePosition(polygon, width, height));
+    if(_item == NULL) return;
+    _item->setPolygon(_polygon);
+}
+
+/*!
+ * \brief 画像上の座標列と、その外接矩形・面積・重心を更新する
+ * \param polygon 画像上の座標列
+ */
+void GraphicsItemData::updateGeometry(const QPolygonF &polygon)
+{
+    _polygon = polygon;
+    _boundingRect = polygon.boundingRect();
+    _areaSize = calcPolygonAreaSize(polygon);
+    _center = getPolygonCenter(polygon);
+}
+
+const QPolygonF &GraphicsItemData::polygon() const
+{
+    return _polygon;
+}
+
+const QRectF &GraphicsItemData::boundingRect() const
+{
+    return _boundingRect;
+}
+
+double GraphicsItemData::areaSize() const
+{
+    return _areaSize;
+}
+
+const QPointF &GraphicsItemData::center() const
+{
+    return _center;
 }
 
-QGraphicsPolygonItem* GraphicsItemData::item()
+GraphicsPolygonView* GraphicsItemData::item()
 {
     return _item;
 }
@@ -0,0 +1,111 @@
+﻿/*! \file
+ *  \brief 画面に表示するためのグラフィックスアイテム用クラスと色設定
+ *  \author Daisuke
+ *  \date 2016/03/13    daisuke コメント編集
+ */
+
+#ifndef GRAPHICSITEMDATA_H
+#define GRAPHICSITEMDATA_H
+#include <QPolygonF>
+#include <QRectF>
+#include <QBrush>
+#include <QPen>
+
+enum GraphicsItemDataColor{
+    GraphicsItemDataColor_Blue,//!frame
+    GraphicsItemDataColor_Red,//!character
+    GraphicsItemDataColor_Green,//!dialog
+    GraphicsItemDataColor_Purple,//!onomatopoeia
+    GraphicsItemDataColor_Yellow,
+    GraphicsItemDataColor_LightBlue,
+};
+
+/*!
+ * \brief 枠等の表示で使用する色設定クラス
+ */
+class GraphicsItemColor{
+public:
+    GraphicsItemColor();
+    GraphicsItemColor(GraphicsItemDataColor colType);
+    void setColorPreset(GraphicsItemDataColor colType);
+    QBrush brush_default;//!通常表示用
+    QPen pen_default;
+    QBrush brush_active;//!選択モードにおいて選択可能な場合
+    QPen pen_active;
+    QBrush brush_selected;//!選択モードに置いて選択された場合
+    QPen pen_selected;
+    QBrush brush_hidden;//!選択モード等において選択不可能な場合
+    QPen pen_hidden;
+    int pw_default;
+    int pw_active;
+    int pw_selected;
+    void initpen();
+};
+
+/*!
+ * \brief 枠を画面に表示するアイテムのインターフェース
+ * メタデータ側はQtWidgetsに依存しないよう、表示用アイテムはこのインターフェース経由で扱う。\n
+ * GUIではQGraphicsPolygonItemを継承した実装をsetGraphicsPolygonViewFactoryで登録する
+ */
+class GraphicsPolygonView
+{
+public:
+    virtual ~GraphicsPolygonView() {}
+    virtual void setPolygon(const QPolygonF &polygon) = 0;
+    virtual QPolygonF polygon() const = 0;
+    virtual void setBrush(const QBrush &brush) = 0;
+    virtual void setPen(const QPen &pen) = 0;
+};
+
+//! 表示用アイテムの生成関数
+typedef GraphicsPolygonView *(*GraphicsPolygonViewFactory)();
+
+/*!
+ * \brief GraphicsItemData生成時に表示用アイテムを生成する関数を登録する
+ * 登録されていない場合（コマンドラインツール等）は表示用アイテムを生成しない。
+ * スレッドを開始する前に一度だけ呼び出す事
+ * \param factory 生成関数（NULLで登録解除）
+ */
+void setGraphicsPolygonViewFactory(GraphicsPolygonViewFactory factory);
+
+/*!
+ * \brief 画面に表示するためのグラフィックスアイテム用クラス
+ * アイテムの実態生成もこのクラスで行う（生成関数が登録されている場合）
+ * 色設定についてはGraphicsItemColorを利用する\n
+ * 画像上の座標列とその外接矩形・面積・重心は、setPolygon/setRelativePolygonで形状が変わった時のみ計算して保持する
+ */
+class GraphicsItemData
+{
+public:
+    GraphicsItemData();
+    GraphicsItemData(GraphicsItemDataColor color);
+    void setPolygon(QPolygonF &polygon, int width, int height);
+    void setRelativePolygon(QPolygonF &polygon, int width, int height);
+    GraphicsPolygonView* _item;
+    GraphicsPolygonView* item();
+    QPolygonF _relativePosition;
+    const QPolygonF &polygon() const; //!<画像上の座標列
+    const QRectF &boundingRect() const; //!<画像上の外接矩形
+    double areaSize() const; //!<画像上の面積
+    const QPointF &center() const; //!<画像上の重心（頂点の平均）
+    void setGraphicsPolygonItem(GraphicsPolygonView* item);
+    void colorDefault();
+    void colorActive();
+    void colorBrushSelected();//ブラシのみ選択状態に変更
+    void colorSelected();
+    void colorHidden();
+    GraphicsItemColor col;
+    void setColorPreset(GraphicsItemDataColor color);
+private:
+    void initbw();
+    void updateGeometry(const QPolygonF &polygon);
+    QPolygonF _polygon; //!<画像上の座標列
+    QRectF _boundingRect; //!<_polygonの外接矩形
+    double _areaSize; //!<_polygonの面積
+    QPointF _center; //!<_polygonの重心
+};
+
+QPolygonF calcRelativePosition(QPolygonF absolutePosition, int width, int height);
+QPolygonF calcAbsolutePosition(QPolygonF relativePosition, int width, int height);
+
+#endif // GRAPHICSITEMDATA_H
@@ -0,0 +1,171 @@
+﻿/*! \file
+ *  \brief メタデータ保存用の追記型ジャーナル 実装部
+ *  \date 2026/10/17 新規作成
+ */
+
+#include "MetadataJournal.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QDataStream>
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+static const quint32 JOURNAL_MAGIC = 0x434d4a31; //!< "CMJ1"
+static const char *JOURNAL_FILE_NAME = "ComicMetadata.journal";
+
+/*!
+ * \brief レコードのチェックサムを計算する
+ */
+static quint32 recordChecksum(const QByteArray &name, const QByteArray &payload)
+{
+    quint32 nameSum = qChecksum(name.constData(), name.size());
+    quint32 payloadSum = qChecksum(payload.constData(), payload.size());
+    return (nameSum << 16) | payloadSum;
+}
+
+/*!
+ * \brief 追記した内容をディスクまで書き出す（電源断に備える）
+ */
+static void syncFile(QFile &file)
+{
+    file.flush();
+#ifdef Q_OS_WIN
+    _commit(file.handle());
+#else
+    fsync(file.handle());
+#endif
+}
+
+MetadataJournal::MetadataJournal(QString directoryPath)
+{
+    _directoryPath = directoryPath;
+    _recordCount = 0;
+}
+
+QString MetadataJournal::directoryPath() const
+{
+    return _directoryPath;
+}
+
+QString MetadataJournal::journalFileName() const
+{
+    return _directoryPath + "/" + JOURNAL_FILE_NAME;
+}
+
+int MetadataJournal::replay()
+{
+    QFile file(journalFileName());
+    if(!file.open(QFile::ReadOnly)) return 0;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+    int count = 0;
+    while(!stream.atEnd()){
+        quint32 magic;
+        QByteArray name;
+        QByteArray payload;
+        quint32 checksum;
+        stream >> magic;
+        if(stream.status() != QDataStream::Ok || magic != JOURNAL_MAGIC) break;
+        stream >> name >> payload >> checksum;
+        //!書き込み途中で中断されたレコード以降は破棄する
+        if(stream.status() != QDataStream::Ok) break;
+        if(checksum != recordChecksum(name, payload)) break;
+        _latest.insert(QString::fromUtf8(name), payload);
+        count++;
+    }
+    _recordCount += count;
+    return count;
+}
+
+bool MetadataJournal::append(QString fileName, const QByteArray &payload)
+{
+    QByteArray name = QFileInfo(fileName).fileName().toUtf8();
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream << JOURNAL_MAGIC << name << payload << recordChecksum(name, payload);
+
+    QFile file(journalFileName());
+    if(!file.open(QFile::WriteOnly | QFile::Append)) return false;
+    if(file.write(record) != record.size()) return false;
+    syncFile(file);
+
+    _latest.insert(QString::fromUtf8(name), payload);
+    _recordCount++;
+    return true;
+}
+
+bool MetadataJournal::latestContent(QString fileName, QByteArray &payload) const
+{
+    QFileInfo info(fileName);
+    if(info.absolutePath() != _directoryPath) return false;
+    QHash<QString, QByteArray>::const_iterator it = _latest.constFind(info.fileName());
+    if(it == _latest.constEnd()) return false;
+    payload = it.value();
+    return true;
+}
+
+int MetadataJournal::recordCount() const
+{
+    return _recordCount;
+}
+
+bool MetadataJournal::isEmpty() const
+{
+    return _latest.isEmpty();
+}
+
+bool MetadataJournal::checkpoint(QStringList *failedFiles)
+{
+    //!各メタデータファイルを一時ファイル経由で置き換える
+    QHash<QString, QByteArray> failed;
+    QHash<QString, QByteArray>::const_iterator it;
+    for(it = _latest.constBegin(); it != _latest.constEnd(); ++it){
+        QString fileName = _directoryPath + "/" + it.key();
+        QSaveFile file(fileName);
+        if(file.open(QFile::WriteOnly) && file.write(it.value()) == it.value().size() && file.commit()){
+            recordWrittenStamp(fileName);
+            continue;
+        }
+        failed.insert(it.key(), it.value());
+        if(failedFiles) failedFiles->push_back(fileName);
+    }
+
+    //!反映できたものはジャーナルから取り除く
+    if(failed.isEmpty()){
+        QFile::remove(journalFileName());
+    }
+    else{
+        QSaveFile journal(journalFileName());
+        if(journal.open(QFile::WriteOnly)){
+            QDataStream stream(&journal);
+            stream.setVersion(QDataStream::Qt_5_0);
+            for(it = failed.constBegin(); it != failed.constEnd(); ++it){
+                QByteArray name = it.key().toUtf8();
+                stream << JOURNAL_MAGIC << name << it.value() << recordChecksum(name, it.value());
+            }
+            journal.commit();
+        }
+    }
+    _latest = failed;
+    _recordCount = failed.size();
+    return failed.isEmpty();
+}
+
+void MetadataJournal::recordWrittenStamp(QString fileName)
+{
+    QFileInfo info(fileName);
+    _writtenStamp.insert(info.fileName(), info.lastModified());
+}
+
+QDateTime MetadataJournal::writtenStamp(QString fileName) const
+{
+    QFileInfo info(fileName);
+    if(info.absolutePath() != _directoryPath) return QDateTime();
+    return _writtenStamp.value(info.fileName());
+}
@@ -0,0 +1,86 @@
+﻿/*! \file
+ *  \brief メタデータ保存用の追記型ジャーナル
+ *  \date 2026/10/17 新規作成
+ */
+
+#ifndef METADATAJOURNAL_H
+#define METADATAJOURNAL_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QHash>
+#include <QDateTime>
+
+/*!
+ * \brief メタデータディレクトリ毎の追記型ジャーナル
+ * 保存要求のあったメタデータファイルの内容を、XMLファイルを書き換える代わりに
+ * ジャーナルファイルへ追記していき、チェックポイントでまとめてXMLファイルへ反映する。\n
+ * レコードは（識別子、ファイル名、内容、チェックサム）の組で、途中で書き込みが中断された
+ * 末尾のレコードはチェックサムにより破棄される。\n
+ * 前回異常終了した場合は、ディレクトリを開いた際にreplay()で残っている内容を読み込み、
+ * チェックポイントを行う事で復旧する
+ */
+class MetadataJournal
+{
+public:
+    /*!
+     * \brief コンストラクタ
+     * \param directoryPath メタデータディレクトリの絶対パス
+     */
+    explicit MetadataJournal(QString directoryPath);
+
+    QString directoryPath() const;
+    QString journalFileName() const;//!<ジャーナルファイル名
+
+    /*!
+     * \brief ジャーナルファイルに残っているレコードを読み込む
+     * \return 読み込めたレコードの数
+     */
+    int replay();
+
+    /*!
+     * \brief レコードを追記する
+     * \param fileName メタデータファイル名
+     * \param payload ファイルの内容
+     * \return 書き込みの成否
+     */
+    bool append(QString fileName, const QByteArray &payload);
+
+    /*!
+     * \brief チェックポイント前の最新の内容を取得する
+     * \param fileName メタデータファイル名
+     * \param payload 内容の格納先
+     * \return ジャーナルに内容が無い場合false
+     */
+    bool latestContent(QString fileName, QByteArray &payload) const;
+
+    int recordCount() const;//!<前回のチェックポイント以降に追記したレコード数
+    bool isEmpty() const;
+
+    /*!
+     * \brief ジャーナルの内容をメタデータファイルに反映し、ジャーナルを空にする
+     * 反映に失敗したファイルの内容はジャーナルに残す
+     * \param failedFiles 反映に失敗したファイル名の格納先
+     * \return 全て反映できた場合true
+     */
+    bool checkpoint(QStringList *failedFiles = 0);
+
+    /*!
+     * \brief 本クラス経由でXMLファイルを書き込んだ際の、ファイルの更新日時を記録する
+     * 自分自身の書き込みによる更新を、外部からの更新と区別するために使う
+     * \param fileName メタデータファイル名
+     */
+    void recordWrittenStamp(QString fileName);
+
+    //! 最後に書き込んだ際のファイルの更新日時（書き込んでいない場合は無効な値）
+    QDateTime writtenStamp(QString fileName) const;
+
+private:
+    QString _directoryPath; //!< メタデータディレクトリの絶対パス
+    QHash<QString, QByteArray> _latest; //!< ファイル名（ディレクトリ内の名前）をキーとした最新の内容
+    int _recordCount; //!< 前回のチェックポイント以降に追記したレコード数
+    QHash<QString, QDateTime> _writtenStamp; //!< ファイル名をキーとした書き込み後の更新日時
+};
+
+#endif // METADATAJOURNAL_H
@@ -0,0 +1,229 @@
+﻿/*! \file
+ *  \brief メタデータファイルのバックグラウンド書き込みキュー 実装部
+ *  \date 2026/10/17 新規作成
+ */
+
+#include "MetadataSaveQueue.h"
+#include <QMutexLocker>
+#include <QBuffer>
+#include <QFileInfo>
+
+//! この数だけジャーナルに追記したらXMLファイルへ反映する
+#define JOURNAL_CHECKPOINT_INTERVAL 64
+
+MetadataSaveQueue::MetadataSaveQueue(QObject *parent) :
+    QThread(parent)
+{
+    _checkpointRequested = false;
+    _stop = false;
+}
+
+MetadataSaveQueue::~MetadataSaveQueue()
+{
+    {
+        QMutexLocker locker(&_mutex);
+        _stop = true;
+        _jobAdded.wakeAll();
+    }
+    //!スレッドは書き込み待ちの保存要求を全て処理してから終了する
+    wait();
+
+    //!ジャーナルの内容を全てXMLファイルへ反映する
+    checkpointJournals();
+    qDeleteAll(_journals);
+}
+
+void MetadataSaveQueue::enqueue(QString fileName, SaveType type, QSharedPointer<ComicMetadata> snapshot)
+{
+    if(fileName.isEmpty() || snapshot.isNull()) return;
+
+    QMutexLocker locker(&_mutex);
+    SaveJob job;
+    job.type = type;
+    job.snapshot = snapshot;
+    if(!_jobs.contains(fileName)){
+        _order.append(fileName);
+    }
+    _jobs.insert(fileName, job);
+    _jobAdded.wakeOne();
+    locker.unlock();
+
+    if(!isRunning()) start(QThread::LowPriority);
+}
+
+void MetadataSaveQueue::waitFor(QString fileName)
+{
+    QMutexLocker locker(&_mutex);
+    while(_jobs.contains(fileName) || _writingFileName == fileName){
+        _jobDone.wait(&_mutex);
+    }
+}
+
+void MetadataSaveQueue::flush()
+{
+    QMutexLocker locker(&_mutex);
+    if(!isRunning()){
+        //!スレッドが動いていなければ、チェックポイントのみここで行う
+        bool requested = _checkpointRequested;
+        _checkpointRequested = false;
+        locker.unlock();
+        if(requested) checkpointJournals();
+        return;
+    }
+    while(!_jobs.isEmpty() || !_writingFileName.isEmpty() || _checkpointRequested){
+        _jobDone.wait(&_mutex);
+    }
+}
+
+void MetadataSaveQueue::checkpoint()
+{
+    QMutexLocker locker(&_mutex);
+    _checkpointRequested = true;
+    _jobAdded.wakeOne();
+}
+
+int MetadataSaveQueue::pendingCount() const
+{
+    QMutexLocker locker(&_mutex);
+    return _jobs.size();
+}
+
+int MetadataSaveQueue::openDirectory(QString directoryPath)
+{
+    QMutexLocker locker(&_journalMutex);
+    int recovered = 0;
+    journal(QFileInfo(directoryPath).absoluteFilePath(), &recovered);
+    return recovered;
+}
+
+bool MetadataSaveQueue::latestContent(QString fileName, QByteArray &payload)
+{
+    QMutexLocker locker(&_journalMutex);
+    MetadataJournal *target = _journals.value(QFileInfo(fileName).absolutePath(), NULL);
+    if(target == NULL) return false;
+    return target->latestContent(fileName, payload);
+}
+
+QDateTime MetadataSaveQueue::writtenStamp(QString fileName)
+{
+    QMutexLocker locker(&_journalMutex);
+    MetadataJournal *target = _journals.value(QFileInfo(fileName).absolutePath(), NULL);
+    if(target == NULL) return QDateTime();
+    return target->writtenStamp(fileName);
+}
+
+/*!
+ * \brief ディレクトリのジャーナルを取得する（_journalMutexをロックした状態で呼ぶ事）
+ * 初めて開くディレクトリであれば、残っているジャーナルを読み込んでXMLファイルへ反映する
+ * \param directoryPath メタデータディレクトリの絶対パス
+ * \param recovered 復旧したレコード数の格納先
+ * \return ジャーナル
+ */
+MetadataJournal *MetadataSaveQueue::journal(QString directoryPath, int *recovered)
+{
+    MetadataJournal *target = _journals.value(directoryPath, NULL);
+    if(target != NULL) return target;
+
+    target = new MetadataJournal(directoryPath);
+    _journals.insert(directoryPath, target);
+    int count = target->replay();
+    if(count > 0){
+        QStringList failedFiles;
+        target->checkpoint(&failedFiles);
+        for(int i=0; i<failedFiles.size(); i++){
+            emit signal_saveFailed(failedFiles.at(i));
+        }
+    }
+    if(recovered) *recovered = count;
+    return target;
+}
+
+/*!
+ * \brief 全てのジャーナルの内容をXMLファイルへ反映する
+ */
+void MetadataSaveQueue::checkpointJournals()
+{
+    QMutexLocker locker(&_journalMutex);
+    QHash<QString, MetadataJournal*>::iterator it;
+    for(it = _journals.begin(); it != _journals.end(); ++it){
+        if(it.value()->isEmpty()) continue;
+        QStringList failedFiles;
+        it.value()->checkpoint(&failedFiles);
+        for(int i=0; i<failedFiles.size(); i++){
+            emit signal_saveFailed(failedFiles.at(i));
+        }
+    }
+}
+
+void MetadataSaveQueue::run()
+{
+    forever{
+        //!保存要求を一件取り出す
+        QMutexLocker locker(&_mutex);
+        while(_order.isEmpty() && !_checkpointRequested && !_stop){
+            _jobAdded.wait(&_mutex);
+        }
+        if(_order.isEmpty()){
+            //!保存要求を処理し終えてからチェックポイントを行う
+            if(_checkpointRequested){
+                locker.unlock();
+                checkpointJournals();
+                locker.relock();
+                _checkpointRequested = false;
+                _jobDone.wakeAll();
+                continue;
+            }
+            break;
+        }
+        QString fileName = _order.takeFirst();
+        SaveJob job = _jobs.take(fileName);
+        _writingFileName = fileName;
+        locker.unlock();
+
+        //!ロックを外した状態でメモリ上にXMLを生成する
+        QByteArray payload;
+        QBuffer buffer(&payload);
+        buffer.open(QIODevice::WriteOnly);
+        bool result;
+        if(job.type == Save_Common){
+            result = job.snapshot.data()->writeMetadata_Common(&buffer);
+        }
+        else{
+            result = job.snapshot.data()->writeMetadata_Page(&buffer);
+        }
+        buffer.close();
+
+        //!ジャーナルへ追記する
+        //追記できなければ、古い内容で上書きされないよう先にジャーナルを反映してからXMLファイルへ直接書き込む
+        if(result){
+            QMutexLocker journalLocker(&_journalMutex);
+            MetadataJournal *target = journal(QFileInfo(fileName).absolutePath());
+            if(!target->append(fileName, payload)){
+                target->checkpoint();
+                if(job.type == Save_Common){
+                    result = job.snapshot.data()->writeMetadata_Common(fileName);
+                }
+                else{
+                    result = job.snapshot.data()->writeMetadata_Page(fileName);
+                }
+                if(result) target->recordWrittenStamp(fileName);
+            }
+            else if(target->recordCount() >= JOURNAL_CHECKPOINT_INTERVAL){
+                QStringList failedFiles;
+                target->checkpoint(&failedFiles);
+                for(int i=0; i<failedFiles.size(); i++){
+                    emit signal_saveFailed(failedFiles.at(i));
+                }
+            }
+        }
+
+        locker.relock();
+        _writingFileName.clear();
+        _jobDone.wakeAll();
+        locker.unlock();
+
+        if(!result){
+            emit signal_saveFailed(fileName);
+        }
+    }
+}
@@ -0,0 +1,123 @@
+﻿/*! \file
+ *  \brief メタデータファイルのバックグラウンド書き込みキュー
+ *  \date 2026/10/17 新規作成
+ */
+
+#ifndef METADATASAVEQUEUE_H
+#define METADATASAVEQUEUE_H
+
+#include "ComicMetadata.h"
+#include "MetadataJournal.h"
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QHash>
+#include <QStringList>
+#include <QSharedPointer>
+
+/*!
+ * \brief メタデータの保存を専用スレッドで行うためのキュー
+ * enqueue()には保存時点のメタデータの複製（ComicMetadata::clone()）を渡すため、
+ * 書き込み中にUI側でメタデータを編集しても影響しない。\n
+ * 書き込み前の同じファイルへの保存要求は、最新のもの1件にまとめられる。\n
+ * 保存内容はメタデータディレクトリ毎のジャーナル（MetadataJournal）に追記し、
+ * 一定数追記した時点、checkpoint()が呼ばれた時点、終了時にまとめてXMLファイルへ反映する。\n
+ * 書き込みに失敗した場合はsignal_saveFailedで通知する
+ */
+class MetadataSaveQueue : public QThread
+{
+    Q_OBJECT
+public:
+    //! 保存するメタデータの種類
+    enum SaveType{
+        Save_Common, //!< 共通メタデータ（書籍情報、登場人物リスト）
+        Save_Page //!< ページメタデータ
+    };
+
+    explicit MetadataSaveQueue(QObject *parent = 0);
+
+    //! 未書き込みの保存要求を全て書き込んでからスレッドを終了する
+    ~MetadataSaveQueue();
+
+    /*!
+     * \brief 保存要求を追加する
+     * 同じファイルへの保存要求が書き込み待ちであれば、その内容を置き換える
+     * \param fileName 出力先メタデータファイル名
+     * \param type 保存するメタデータの種類
+     * \param snapshot 保存するメタデータの複製
+     */
+    void enqueue(QString fileName, SaveType type, QSharedPointer<ComicMetadata> snapshot);
+
+    /*!
+     * \brief 指定されたファイルへの書き込みが終わるまで待つ
+     * 保存要求が無ければすぐに戻る。ファイルを読み込む前に呼び出す事
+     * \param fileName メタデータファイル名
+     */
+    void waitFor(QString fileName);
+
+    //! 全ての保存要求の書き込みが終わるまで待つ
+    void flush();
+
+    /*!
+     * \brief ジャーナルの内容をXMLファイルへ反映するよう要求する
+     * 反映は書き込み待ちの保存要求を処理した後に行われる。完了を待つ場合はflush()を呼ぶ事
+     */
+    void checkpoint();
+
+    /*!
+     * \brief メタデータディレクトリを開く
+     * 初めて開くディレクトリにジャーナルが残っていた場合（前回の異常終了時）は、
+     * その内容をXMLファイルへ反映する
+     * \param directoryPath メタデータディレクトリの絶対パス
+     * \return ジャーナルから復旧したレコードの数
+     */
+    int openDirectory(QString directoryPath);
+
+    /*!
+     * \brief XMLファイルへ未反映の最新の内容を取得する
+     * \param fileName メタデータファイル名
+     * \param payload 内容の格納先
+     * \return 未反映の内容が無い場合false（XMLファイルを読み込めばよい）
+     */
+    bool latestContent(QString fileName, QByteArray &payload);
+
+    /*!
+     * \brief 本キューが最後にXMLファイルを書き込んだ際の、ファイルの更新日時を取得する
+     * \param fileName メタデータファイル名
+     * \return 更新日時（書き込んでいない場合は無効な値）
+     */
+    QDateTime writtenStamp(QString fileName);
+
+    //! 書き込み待ちの保存要求の数
+    int pendingCount() const;
+
+signals:
+    void signal_saveFailed(QString fileName);
+
+protected:
+    void run();
+
+private:
+    //! 保存要求
+    struct SaveJob{
+        SaveType type;
+        QSharedPointer<ComicMetadata> snapshot;
+    };
+
+    MetadataJournal *journal(QString directoryPath, int *recovered = 0);
+    void checkpointJournals();
+
+    mutable QMutex _mutex; //!< 以下のメンバの保護用
+    QWaitCondition _jobAdded; //!< 保存要求の追加、終了要求の通知用
+    QWaitCondition _jobDone; //!< 書き込み完了の通知用
+    QHash<QString, SaveJob> _jobs; //!< ファイル名をキーとした書き込み待ちの保存要求
+    QStringList _order; //!< 保存要求を受け付けた順のファイル名
+    QString _writingFileName; //!< 書き込み中のファイル名
+    bool _checkpointRequested; //!< チェックポイントの要求
+    bool _stop; //!< スレッドの終了要求
+
+    QMutex _journalMutex; //!< ジャーナルの保護用
+    QHash<QString, MetadataJournal*> _journals; //!< ディレクトリの絶対パスをキーとしたジャーナル
+};
+
+#endif // METADATASAVEQUEUE_H
@@ -0,0 +1,191 @@
+﻿/*! \file
+ *  \brief ポリゴンの当たり判定用の空間インデックス 実装部
+ *  \date 2026/10/17 新規作成
+ */
+
+#include "PolygonGridIndex.h"
+#include "CommonFunction.h"
+#include "GraphicsItemData.h"
+#include <QRect>
+#include <cmath>
+
+PolygonGridIndex::PolygonGridIndex(double cellSize)
+{
+    _cellSize = cellSize > 0 ? cellSize : 128.0;
+}
+
+void PolygonGridIndex::clear()
+{
+    _ids.clear();
+    _entries.clear();
+    _cells.clear();
+}
+
+int PolygonGridIndex::size() const
+{
+    return _ids.size();
+}
+
+void PolygonGridIndex::append(const QPolygonF &polygon)
+{
+    append(polygon, polygon.boundingRect(), calcPolygonAreaSize(polygon));
+}
+
+void PolygonGridIndex::append(const GraphicsItemData &GIData)
+{
+    append(GIData.polygon(), GIData.boundingRect(), GIData.areaSize());
+}
+
+void PolygonGridIndex::append(const QPolygonF &polygon, const QRectF &bounds, double area)
+{
+    Entry entry;
+    entry.polygon = polygon;
+    entry.bounds = bounds;
+    entry.area = area;
+    entry.active = true;
+    quint32 id = _ids.append();
+    _entries.resize(id + 1);
+    _entries[id] = entry;
+    insertCells(id);
+}
+
+void PolygonGridIndex::replace(int number, const QPolygonF &polygon)
+{
+    replace(number, polygon, polygon.boundingRect(), calcPolygonAreaSize(polygon));
+}
+
+void PolygonGridIndex::replace(int number, const GraphicsItemData &GIData)
+{
+    replace(number, GIData.polygon(), GIData.boundingRect(), GIData.areaSize());
+}
+
+void PolygonGridIndex::replace(int number, const QPolygonF &polygon, const QRectF &bounds, double area)
+{
+    quint32 id = _ids.id(number);
+    if(id == 0) return;
+    removeCells(id);
+    Entry &entry = _entries[id];
+    entry.polygon = polygon;
+    entry.bounds = bounds;
+    entry.area = area;
+    insertCells(id);
+}
+
+void PolygonGridIndex::removeAt(int number)
+{
+    quint32 id = _ids.id(number);
+    if(id == 0) return;
+    removeCells(id);
+    _entries[id] = Entry();
+
+    //!以降の番号はIDとの対応表のみで詰める（格子にはIDを登録しているため書き換えない）
+    _ids.removeAt(number);
+}
+
+void PolygonGridIndex::setActive(int number, bool active)
+{
+    quint32 id = _ids.id(number);
+    if(id == 0) return;
+    if(_entries.at(id).active == active) return;
+    if(active){
+        _entries[id].active = true;
+        insertCells(id);
+    }
+    else{
+        removeCells(id);
+        _entries[id].active = false;
+    }
+}
+
+bool PolygonGridIndex::isActive(int number) const
+{
+    quint32 id = _ids.id(number);
+    if(id == 0) return false;
+    return _entries.at(id).active;
+}
+
+const QPolygonF &PolygonGridIndex::polygon(int number) const
+{
+    return _entries.at(_ids.id(number)).polygon;
+}
+
+double PolygonGridIndex::area(int number) const
+{
+    return _entries.at(_ids.id(number)).area;
+}
+
+int PolygonGridIndex::smallestContaining(QPointF pt) const
+{
+    QHash<quint64, QVector<quint32> >::const_iterator cell = _cells.constFind(
+                cellKey(int(std::floor(pt.x() / _cellSize)), int(std::floor(pt.y() / _cellSize))));
+    if(cell == _cells.constEnd()) return -1;
+
+    int selected = -1;
+    double minArea = 0;
+    const QVector<quint32> &ids = cell.value();
+    for(int i=0; i<ids.size(); i++){
+        const Entry &entry = _entries.at(ids.at(i));
+        if(!entry.bounds.contains(pt)) continue;
+        if(selected >= 0 && entry.area > minArea) continue;
+        if(!entry.polygon.containsPoint(pt, Qt::WindingFill)) continue;
+        //!番号は候補になったものについてのみ求める
+        int number = _ids.number(ids.at(i));
+        if(selected >= 0 && entry.area == minArea && number > selected) continue;
+        selected = number;
+        minArea = entry.area;
+    }
+    return selected;
+}
+
+void PolygonGridIndex::candidates(QPointF pt, QVector<int> &numbers) const
+{
+    numbers.clear();
+    QHash<quint64, QVector<quint32> >::const_iterator cell = _cells.constFind(
+                cellKey(int(std::floor(pt.x() / _cellSize)), int(std::floor(pt.y() / _cellSize))));
+    if(cell == _cells.constEnd()) return;
+    const QVector<quint32> &ids = cell.value();
+    for(int i=0; i<ids.size(); i++){
+        if(_entries.at(ids.at(i)).bounds.contains(pt)) numbers.push_back(_ids.number(ids.at(i)));
+    }
+}
+
+quint64 PolygonGridIndex::cellKey(int x, int y) const
+{
+    return (quint64(quint32(x)) << 32) | quint32(y);
+}
+
+QRect PolygonGridIndex::cellRange(const QRectF &bounds) const
+{
+    int left = int(std::floor(bounds.left() / _cellSize));
+    int top = int(std::floor(bounds.top() / _cellSize));
+    int right = int(std::floor(bounds.right() / _cellSize));
+    int bottom = int(std::floor(bounds.bottom() / _cellSize));
+    return QRect(QPoint(left, top), QPoint(right, bottom));
+}
+
+void PolygonGridIndex::insertCells(quint32 id)
+{
+    const Entry &entry = _entries.at(id);
+    if(!entry.active || entry.polygon.isEmpty()) return;
+    QRect range = cellRange(entry.bounds);
+    for(int y=range.top(); y<=range.bottom(); y++){
+        for(int x=range.left(); x<=range.right(); x++){
+            _cells[cellKey(x, y)].push_back(id);
+        }
+    }
+}
+
+void PolygonGridIndex::removeCells(quint32 id)
+{
+    const Entry &entry = _entries.at(id);
+    if(!entry.active || entry.polygon.isEmpty()) return;
+    QRect range = cellRange(entry.bounds);
+    for(int y=range.top(); y<=range.bottom(); y++){
+        for(int x=range.left(); x<=range.right(); x++){
+            QHash<quint64, QVector<quint32> >::iterator cell = _cells.find(cellKey(x, y));
+            if(cell == _cells.end()) continue;
+            cell.value().removeOne(id);
+            if(cell.value().isEmpty()) _cells.erase(cell);
+        }
+    }
+}
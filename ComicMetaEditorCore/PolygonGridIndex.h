@@ -0,0 +1,93 @@
+﻿/*! \file
+ *  \brief ポリゴンの当たり判定用の空間インデックス
+ *  \date 2026/10/17 新規作成
+ */
+
+#ifndef POLYGONGRIDINDEX_H
+#define POLYGONGRIDINDEX_H
+
+#include "StableIdIndex.h"
+#include <QPolygonF>
+#include <QRectF>
+#include <QVector>
+#include <QHash>
+
+class GraphicsItemData;
+
+/*!
+ * \brief ポリゴンの外接矩形を一定サイズの格子に登録した空間インデックス
+ * 点を含むポリゴンの検索を、その点の属する格子に登録されたポリゴンのみで行うため、
+ * 検索コストはページ全体のポリゴン数ではなく近傍のポリゴン数に比例する。\n
+ * ポリゴンは登録順の番号（メタデータのリストのインデックスと同じ）で識別し、
+ * 追加・変更・削除はそのポリゴンが掛かる格子のみを更新する。
+ * 格子には番号ではなく削除で変わらないIDを登録するため、削除時に他のポリゴンの格子を書き換える必要はない。\n
+ * setActiveで一時的に検索対象から外す事もできる（順番設定モードで選択済みのもの等）
+ */
+class PolygonGridIndex
+{
+public:
+    /*!
+     * \brief コンストラクタ
+     * \param cellSize 格子の一辺の長さ（ポリゴンと同じ座標系）
+     */
+    explicit PolygonGridIndex(double cellSize = 128.0);
+
+    void clear(); //!<全てのポリゴンを削除する
+    int size() const; //!<登録されているポリゴン数
+
+    void append(const QPolygonF &polygon); //!<末尾に追加する（番号はsize()-1となる）
+    void replace(int number, const QPolygonF &polygon); //!<指定した番号のポリゴンを置き換える
+    void append(const GraphicsItemData &GIData); //!<GraphicsItemDataが保持する外接矩形・面積をそのまま使って追加する
+    void replace(int number, const GraphicsItemData &GIData); //!<GraphicsItemDataが保持する外接矩形・面積をそのまま使って置き換える
+    void removeAt(int number); //!<指定した番号のポリゴンを削除し、以降の番号を1つずつ詰める
+
+    /*!
+     * \brief ポリゴンを検索対象に含めるかどうかを切り替える
+     * 対象外にしたポリゴンは格子から外すため、検索対象は対象外にした分だけ少なくなる（番号はそのまま）
+     * \param number ポリゴンの番号
+     * \param active 検索対象に含める場合true
+     */
+    void setActive(int number, bool active);
+    bool isActive(int number) const; //!<検索対象に含まれているかどうか
+
+    const QPolygonF &polygon(int number) const; //!<登録されているポリゴン
+    double area(int number) const; //!<登録されているポリゴンの面積
+
+    /*!
+     * \brief 点を含むポリゴンのうち、面積が最小のものを検索する
+     * 面積が同じ場合は番号の小さいものを優先する
+     * \param pt 点
+     * \return ポリゴンの番号（無い場合-1）
+     */
+    int smallestContaining(QPointF pt) const;
+
+    /*!
+     * \brief 外接矩形が点を含むポリゴンの番号を列挙する（順不同）
+     * \param pt 点
+     * \param numbers 格納先（先に消去される）
+     */
+    void candidates(QPointF pt, QVector<int> &numbers) const;
+
+private:
+    struct Entry
+    {
+        Entry() : area(0), active(false) {}
+        QPolygonF polygon;
+        QRectF bounds; //!<外接矩形
+        double area;
+        bool active; //!<検索対象に含まれている場合true
+    };
+    void append(const QPolygonF &polygon, const QRectF &bounds, double area);
+    void replace(int number, const QPolygonF &polygon, const QRectF &bounds, double area);
+    quint64 cellKey(int x, int y) const;
+    QRect cellRange(const QRectF &bounds) const; //!<外接矩形が掛かる格子の範囲
+    void insertCells(quint32 id);
+    void removeCells(quint32 id);
+
+    double _cellSize;
+    StableIdIndex _ids; //!<番号とIDの対応
+    QVector<Entry> _entries; //!<IDをインデックスとしたポリゴン（削除されたものは空、clearまで再利用しない）
+    QHash<quint64, QVector<quint32> > _cells; //!<格子毎の登録ID
+};
+
+#endif // POLYGONGRIDINDEX_H
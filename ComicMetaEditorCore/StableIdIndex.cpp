@@ -0,0 +1,75 @@
+﻿/*! \file
+ *  \brief メタデータのリストの要素に固定のIDを割り当てる索引 実装部
+ *  \date 2026/10/17 新規作成
+ */
+
+#include "StableIdIndex.h"
+
+StableIdIndex::StableIdIndex()
+{
+    _nextId = 1;
+}
+
+void StableIdIndex::clear()
+{
+    _ids.clear();
+    _numbers.clear();
+    _nextId = 1;
+}
+
+int StableIdIndex::size() const
+{
+    return _ids.size();
+}
+
+quint32 StableIdIndex::append()
+{
+    quint32 id = _nextId++;
+    _numbers.insert(id, _ids.size());
+    _ids.push_back(id);
+    return id;
+}
+
+void StableIdIndex::removeAt(int number)
+{
+    if(number < 0 || number >= _ids.size()) return;
+    _numbers.remove(_ids.at(number));
+    _ids.remove(number);
+
+    //!以降の要素の番号を詰める（削除した位置より後ろのみ）
+    for(int i=number; i<_ids.size(); i++){
+        _numbers[_ids.at(i)] = i;
+    }
+}
+
+bool StableIdIndex::reorder(const QVector<int> &order)
+{
+    if(order.size() != _ids.size()) return false;
+
+    //!全ての番号がちょうど1回ずつ現れる事を確認する
+    QVector<bool> used(_ids.size(), false);
+    for(int i=0; i<order.size(); i++){
+        int from = order.at(i);
+        if(from < 0 || from >= _ids.size() || used.at(from)) return false;
+        used[from] = true;
+    }
+
+    QVector<quint32> ids(_ids.size());
+    for(int i=0; i<order.size(); i++){
+        ids[i] = _ids.at(order.at(i));
+        _numbers[ids.at(i)] = i;
+    }
+    _ids = ids;
+    return true;
+}
+
+quint32 StableIdIndex::id(int number) const
+{
+    if(number < 0 || number >= _ids.size()) return 0;
+    return _ids.at(number);
+}
+
+int StableIdIndex::number(quint32 id) const
+{
+    return _numbers.value(id, -1);
+}
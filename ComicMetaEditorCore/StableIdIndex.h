@@ -0,0 +1,45 @@
+﻿/*! \file
+ *  \brief メタデータのリストの要素に固定のIDを割り当てる索引
+ *  \date 2026/10/17 新規作成
+ */
+
+#ifndef STABLEIDINDEX_H
+#define STABLEIDINDEX_H
+
+#include <QVector>
+#include <QHash>
+
+/*!
+ * \brief リストの各要素に、削除・並べ替えを行っても変わらないIDを割り当てる索引
+ * リストの番号（位置）からIDを、IDから現在の番号を、どちらも定数時間で求められる。\n
+ * IDは1から順に割り当て、clear()するまで再利用しない（0は「無し」を表す）。
+ * 要素の追加・削除・並べ替えはリスト本体と同じ順序でこの索引にも行う事
+ */
+class StableIdIndex
+{
+public:
+    StableIdIndex();
+
+    void clear(); //!<全てのIDを削除する（次に割り当てるIDも1に戻す）
+    int size() const; //!<登録されている要素数
+
+    quint32 append(); //!<末尾の要素に新しいIDを割り当てる
+    void removeAt(int number); //!<指定した番号の要素を削除し、以降の番号を1つずつ詰める
+
+    /*!
+     * \brief 要素を並べ替える
+     * \param order 並べ替え後のi番目の要素の、並べ替え前の番号（要素数はsize()と同じ）
+     * \return 並べ替えた場合true（orderが不正な場合は何もせずfalse）
+     */
+    bool reorder(const QVector<int> &order);
+
+    quint32 id(int number) const; //!<指定した番号の要素のID（範囲外の場合0）
+    int number(quint32 id) const; //!<指定したIDの要素の現在の番号（無い場合-1）
+
+private:
+    QVector<quint32> _ids; //!<番号毎のID
+    QHash<quint32, int> _numbers; //!<ID毎の番号
+    quint32 _nextId; //!<次に割り当てるID
+};
+
+#endif // STABLEIDINDEX_H
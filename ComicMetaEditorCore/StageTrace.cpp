@@ -0,0 +1,267 @@
+﻿/*! \file
+ *  \brief 処理段階毎の所要時間の計測（トレース） 実装部
+ *  \date 2026/10/17 新規作成
+ */
+
+#include "StageTrace.h"
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPair>
+#include <QSaveFile>
+#include <QStringList>
+#include <QThread>
+#include <QVector>
+#include <algorithm>
+
+namespace {
+
+//! ヒストグラムの区間数（区間iは所要時間が2^i μs未満、区間0は1μs未満）
+const int BUCKET_COUNT = 32;
+
+struct TraceEvent
+{
+    const char *name;
+    qint64 start;
+    qint64 duration;
+    int thread; //!<スレッドの通し番号
+};
+
+struct StageStatistics
+{
+    StageStatistics() : count(0), total(0), max(0)
+    {
+        std::fill(buckets, buckets + BUCKET_COUNT, 0);
+    }
+    qint64 count;
+    qint64 total;
+    qint64 max;
+    qint64 buckets[BUCKET_COUNT];
+};
+
+struct TraceData
+{
+    TraceData() : dropped(0) { clock.start(); }
+    QMutex mutex;
+    QElapsedTimer clock;
+    QVector<TraceEvent> events;
+    QHash<QByteArray, StageStatistics> statistics;
+    QHash<Qt::HANDLE, int> threadNumber;
+    QStringList threadName; //!<スレッドの通し番号順
+    int dropped;
+};
+
+QAtomicInt g_enabled(0);
+
+TraceData &traceData()
+{
+    static TraceData data;
+    return data;
+}
+
+int bucketIndex(qint64 durationNs)
+{
+    qint64 us = durationNs / 1000;
+    int index = 0;
+    while(us > 0 && index < BUCKET_COUNT - 1){
+        us >>= 1;
+        index++;
+    }
+    return index;
+}
+
+double bucketUpperBoundMs(int index)
+{
+    return double(qint64(1) << index) / 1000.0;
+}
+
+//! ヒストグラムからパーセンタイルを見積もる（該当区間の上限値、最大値を超えない）
+double percentileMs(const StageStatistics &stat, double ratio)
+{
+    qint64 threshold = qint64(stat.count * ratio + 0.5);
+    qint64 cumulative = 0;
+    for(int i=0; i<BUCKET_COUNT; i++){
+        cumulative += stat.buckets[i];
+        if(cumulative >= threshold && cumulative > 0){
+            return qMin(bucketUpperBoundMs(i), stat.max / 1e6);
+        }
+    }
+    return stat.max / 1e6;
+}
+
+QByteArray jsonString(const QByteArray &text)
+{
+    QByteArray escaped = text;
+    escaped.replace('\\', "\\\\").replace('"', "\\\"");
+    return '"' + escaped + '"';
+}
+
+bool statisticsGreater(const QPair<QByteArray, StageStatistics> &a, const QPair<QByteArray, StageStatistics> &b)
+{
+    return a.second.total > b.second.total;
+}
+
+} // namespace
+
+void StageTrace::setEnabled(bool enabled)
+{
+    g_enabled.storeRelease(enabled ? 1 : 0);
+}
+
+bool StageTrace::isEnabled()
+{
+    return g_enabled.loadAcquire() != 0;
+}
+
+void StageTrace::clear()
+{
+    TraceData &data = traceData();
+    QMutexLocker locker(&data.mutex);
+    data.events.clear();
+    data.statistics.clear();
+    data.dropped = 0;
+}
+
+qint64 StageTrace::now()
+{
+    return traceData().clock.nsecsElapsed();
+}
+
+void StageTrace::record(const char *name, qint64 startNs, qint64 durationNs)
+{
+    TraceData &data = traceData();
+    Qt::HANDLE thread = QThread::currentThreadId();
+    QMutexLocker locker(&data.mutex);
+
+    //!初めて記録するスレッドには通し番号と名前を割り当てる
+    QHash<Qt::HANDLE, int>::const_iterator it = data.threadNumber.constFind(thread);
+    int number;
+    if(it != data.threadNumber.constEnd()){
+        number = it.value();
+    }
+    else{
+        number = data.threadName.size();
+        data.threadNumber.insert(thread, number);
+        bool isMain = QCoreApplication::instance() != NULL
+                && QThread::currentThread() == QCoreApplication::instance()->thread();
+        data.threadName.push_back(isMain ? QString("Main") : QString("Worker %1").arg(number));
+    }
+
+    StageStatistics &stat = data.statistics[QByteArray::fromRawData(name, int(qstrlen(name)))];
+    stat.count++;
+    stat.total += durationNs;
+    stat.max = qMax(stat.max, durationNs);
+    stat.buckets[bucketIndex(durationNs)]++;
+
+    if(data.events.size() >= MAX_EVENT_COUNT){
+        data.dropped++;
+        return;
+    }
+    TraceEvent event;
+    event.name = name;
+    event.start = startNs;
+    event.duration = durationNs;
+    event.thread = number;
+    data.events.push_back(event);
+}
+
+int StageTrace::eventCount()
+{
+    TraceData &data = traceData();
+    QMutexLocker locker(&data.mutex);
+    return data.events.size();
+}
+
+int StageTrace::droppedEventCount()
+{
+    TraceData &data = traceData();
+    QMutexLocker locker(&data.mutex);
+    return data.dropped;
+}
+
+bool StageTrace::writeChromeTrace(QString fileName)
+{
+    //!記録を止めずに出力できるよう、複製してから書き込む
+    TraceData &data = traceData();
+    QVector<TraceEvent> events;
+    QStringList threadName;
+    {
+        QMutexLocker locker(&data.mutex);
+        events = data.events;
+        threadName = data.threadName;
+    }
+
+    QSaveFile file(fileName);
+    if(!file.open(QIODevice::WriteOnly)) return false;
+    QByteArray pid = QByteArray::number(QCoreApplication::applicationPid());
+    QByteArray out;
+    out.reserve(1 << 20);
+    out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    for(int i=0; i<threadName.size(); i++){
+        out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + pid
+                + ",\"tid\":" + QByteArray::number(i)
+                + ",\"args\":{\"name\":" + jsonString(threadName.at(i).toUtf8()) + "}},\n";
+    }
+    for(int i=0; i<events.size(); i++){
+        const TraceEvent &event = events.at(i);
+        out += "{\"name\":" + jsonString(QByteArray(event.name))
+                + ",\"cat\":\"stage\",\"ph\":\"X\",\"ts\":" + QByteArray::number(event.start / 1000.0, 'f', 3)
+                + ",\"dur\":" + QByteArray::number(event.duration / 1000.0, 'f', 3)
+                + ",\"pid\":" + pid + ",\"tid\":" + QByteArray::number(event.thread) + "}";
+        out += (i + 1 < events.size()) ? ",\n" : "\n";
+        if(out.size() >= (1 << 20)){
+            if(file.write(out) != out.size()) return false;
+            out.clear();
+        }
+    }
+    out += "]}\n";
+    if(file.write(out) != out.size()) return false;
+    return file.commit();
+}
+
+QString StageTrace::summary()
+{
+    TraceData &data = traceData();
+    QList<QPair<QByteArray, StageStatistics> > stages;
+    int dropped;
+    {
+        QMutexLocker locker(&data.mutex);
+        for(QHash<QByteArray, StageStatistics>::const_iterator it = data.statistics.constBegin();
+            it != data.statistics.constEnd(); ++it){
+            stages.push_back(qMakePair(it.key(), it.value()));
+        }
+        dropped = data.dropped;
+    }
+    std::sort(stages.begin(), stages.end(), statisticsGreater);
+
+    //!合計時間の大きい順に、1ステージにつき集計行とヒストグラム行を出力する
+    QString text = QString("%1 %2 %3 %4 %5 %6 %7 %8\n")
+            .arg("stage", -32).arg("count", 8).arg("total[ms]", 12).arg("mean[ms]", 10)
+            .arg("p50[ms]", 10).arg("p90[ms]", 10).arg("p99[ms]", 10).arg("max[ms]", 10);
+    for(int i=0; i<stages.size(); i++){
+        const StageStatistics &stat = stages.at(i).second;
+        text += QString("%1 %2 %3 %4 %5 %6 %7 %8\n")
+                .arg(QString::fromUtf8(stages.at(i).first), -32)
+                .arg(stat.count, 8)
+                .arg(stat.total / 1e6, 12, 'f', 3)
+                .arg(stat.total / 1e6 / stat.count, 10, 'f', 3)
+                .arg(percentileMs(stat, 0.5), 10, 'f', 3)
+                .arg(percentileMs(stat, 0.9), 10, 'f', 3)
+                .arg(percentileMs(stat, 0.99), 10, 'f', 3)
+                .arg(stat.max / 1e6, 10, 'f', 3);
+        QString histogram;
+        for(int b=0; b<BUCKET_COUNT; b++){
+            if(stat.buckets[b] == 0) continue;
+            histogram += QString(" <%1ms:%2").arg(bucketUpperBoundMs(b)).arg(stat.buckets[b]);
+        }
+        text += QString("    histogram%1\n").arg(histogram);
+    }
+    if(dropped > 0){
+        text += QString("(%1 events were not kept for the trace file; the statistics include them)\n").arg(dropped);
+    }
+    return text;
+}
@@ -0,0 +1,81 @@
+﻿/*! \file
+ *  \brief 処理段階毎の所要時間の計測（トレース）
+ *  \date 2026/10/17 新規作成
+ */
+
+#ifndef STAGETRACE_H
+#define STAGETRACE_H
+
+#include <QString>
+#include <QtGlobal>
+
+/*!
+ * \brief 処理段階（ステージ）毎の所要時間を記録するクラス
+ * STAGE_TRACE("名前")を置いたスコープの開始から終了までを1件のイベントとして記録し、
+ * Chromeのトレースイベント形式（chrome://tracing, Perfetto）のJSONファイルと、
+ * ステージ毎の所要時間のヒストグラムを出力する。\n
+ * 記録はsetEnabled(true)の間のみ行い、無効時のオーバーヘッドはフラグの読み込み1回のみ。
+ * 全ての関数はスレッドセーフであり、ワーカースレッドからも記録できる
+ */
+class StageTrace
+{
+public:
+    static void setEnabled(bool enabled); //!<記録の有効・無効を切り替える
+    static bool isEnabled(); //!<記録が有効かどうか
+    static void clear(); //!<記録済みのイベントと集計を消去する
+
+    /*!
+     * \brief 1件のイベントを記録する（通常はStageTraceScope経由で使用する）
+     * \param name ステージ名（文字列リテラル等、プログラム終了まで有効なもの）
+     * \param startNs 開始時刻（now()の値）
+     * \param durationNs 所要時間
+     */
+    static void record(const char *name, qint64 startNs, qint64 durationNs);
+    static qint64 now(); //!<トレース用の時刻（ns、単調増加）
+
+    static int eventCount(); //!<記録済みのイベント数
+    static int droppedEventCount(); //!<上限を超えたため記録しなかったイベント数
+
+    /*!
+     * \brief 記録済みのイベントをChromeのトレースイベント形式で出力する
+     * \param fileName 出力先ファイル名
+     * \return 出力の成否
+     */
+    static bool writeChromeTrace(QString fileName);
+
+    /*!
+     * \brief ステージ毎の集計結果（回数、合計、平均、最大、パーセンタイル、ヒストグラム）
+     * \return 表形式のテキスト
+     */
+    static QString summary();
+
+    static const int MAX_EVENT_COUNT = 1000000; //!<保持するイベント数の上限（集計は上限を超えても行う）
+};
+
+/*!
+ * \brief スコープの開始から終了までをStageTraceに記録するクラス
+ */
+class StageTraceScope
+{
+public:
+    explicit StageTraceScope(const char *name)
+    {
+        _name = StageTrace::isEnabled() ? name : NULL;
+        _start = _name ? StageTrace::now() : 0;
+    }
+    ~StageTraceScope()
+    {
+        if(_name) StageTrace::record(_name, _start, StageTrace::now() - _start);
+    }
+private:
+    Q_DISABLE_COPY(StageTraceScope)
+    const char *_name; //!<無効時はNULL
+    qint64 _start;
+};
+
+#define STAGE_TRACE_CONCAT_(a, b) a##b
+#define STAGE_TRACE_CONCAT(a, b) STAGE_TRACE_CONCAT_(a, b)
+//! 現在のスコープをステージとして記録する
+#define STAGE_TRACE(name) StageTraceScope STAGE_TRACE_CONCAT(stageTraceScope_, __LINE__)(name)
+
+#endif // STAGETRACE_H
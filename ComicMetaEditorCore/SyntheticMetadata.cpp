@@ -0,0 +1,282 @@
+﻿/*! \file
+ *  \brief 負荷試験・ベンチマーク用の合成メタデータ生成 実装部
+ *  \date 2026/10/17 新規作成
+ */
+
+#include "SyntheticMetadata.h"
+#include <QtMath>
+
+SyntheticRandom::SyntheticRandom(quint32 seed)
+{
+    std::seed_seq sequence{seed};
+    _engine.seed(sequence);
+}
+
+int SyntheticRandom::integer(int min, int max)
+{
+    //!剰余による偏りが出ないよう、範囲の倍数に収まらない出力は捨てて引き直す
+    if(max <= min) return min;
+    quint64 range = (quint64)((qint64)max - min) + 1;
+    quint64 limit = (Q_UINT64_C(1) << 32) / range * range;
+    quint64 value;
+    do{
+        value = _engine();
+    }while(value >= limit);
+    return (int)(min + (qint64)(value % range));
+}
+
+double SyntheticRandom::real(double min, double max)
+{
+    //!mt19937の出力2回分から53ビットの仮数を作る
+    quint64 high = _engine() >> 5;
+    quint64 low = _engine() >> 6;
+    double unit = (high * 67108864.0 + low) / 9007199254740992.0; //(上位27ビット * 2^26 + 下位26ビット) / 2^53
+    return min + (max - min) * unit;
+}
+
+QPolygonF createSyntheticPolygon(SyntheticRandom &random, QRectF rect, int vertexCount)
+{
+    QPolygonF polygon;
+    QPointF center = rect.center();
+    double phase = random.real(0, 2.0 * M_PI / vertexCount);
+    for(int i=0; i<vertexCount; i++){
+        double angle = phase + 2.0 * M_PI * i / vertexCount;
+        double scale = random.real(0.85, 1.0);
+        polygon << QPointF(center.x() + qCos(angle) * rect.width() / 2.0 * scale,
+                           center.y() + qSin(angle) * rect.height() / 2.0 * scale);
+    }
+    return polygon;
+}
+
+QRectF createSyntheticRect(SyntheticRandom &random, QRectF area, double minScale, double maxScale)
+{
+    double w = area.width() * random.real(minScale, maxScale);
+    double h = area.height() * random.real(minScale, maxScale);
+    double x = area.left() + (area.width() - w) * random.real(0, 1);
+    double y = area.top() + (area.height() - h) * random.real(0, 1);
+    return QRectF(x, y, w, h);
+}
+
+namespace {
+
+const char *DIALOG_PHRASE[] = {
+    "おはよう", "どうしてここに？", "待ってくれ！", "そんなはずはない", "行くぞ",
+    "ありがとう", "まさか……", "早く逃げろ", "今日はいい天気だね", "約束だよ"
+};
+const char *ONOMATOPOEIA_TEXT[] = {
+    "ドドド", "ガシャーン", "ザワザワ", "バーン", "シーン", "ゴゴゴ", "キラッ", "ドキドキ"
+};
+const char *ITEM_CLASS[] = {
+    "Item", "Vehicle", "Building", "Weapon", "Animal"
+};
+
+template <typename T, int N>
+int arraySize(T (&)[N])
+{
+    return N;
+}
+
+/*!
+ * \brief 矩形の外周に沿ったポリゴンを生成する（コマ用）
+ * 4隅を頂点とし、残りの頂点は各辺上に振り分ける。
+ * 頂点数が3以下の場合は、矩形を対角線で分けた三角形のコマとする
+ */
+QPolygonF createRectangularPolygon(QRectF rect, int vertexCount)
+{
+    if(vertexCount <= 3){
+        return QPolygonF() << rect.topLeft() << rect.topRight() << rect.bottomLeft();
+    }
+    QPointF corner[4] = {rect.topLeft(), rect.topRight(), rect.bottomRight(), rect.bottomLeft()};
+    int extra = vertexCount - 4;
+    QPolygonF polygon;
+    for(int side=0; side<4; side++){
+        QPointF from = corner[side];
+        QPointF to = corner[(side + 1) % 4];
+        int count = extra / 4 + (side < extra % 4 ? 1 : 0);
+        polygon << from;
+        for(int i=1; i<=count; i++){
+            polygon << from + (to - from) * (double(i) / (count + 1));
+        }
+    }
+    return polygon;
+}
+
+/*!
+ * \brief コマ間の間隔を求める
+ * コマ数が多い場合でもコマの大きさが負にならないよう、間隔はコマの間隔の1/4までとする
+ * \param length 並べる範囲の長さ
+ * \param count 並べるコマ数
+ */
+double calcGutter(double length, int count)
+{
+    const double gutter = 0.015;
+    return qMin(gutter, length / count / 4.0);
+}
+
+/*!
+ * \brief ページを行単位に分割してコマの矩形を求める（相対座標）
+ */
+QVector<QRectF> layoutFrames(SyntheticRandom &random, int frameCount)
+{
+    QVector<QRectF> frames;
+    if(frameCount <= 0) return frames;
+
+    const double margin = 0.04;
+    const double length = 1.0 - margin * 2;
+    int rows = qCeil(qSqrt(double(frameCount)));
+    double rowGutter = calcGutter(length, rows);
+    double rowHeight = (length - rowGutter * (rows - 1)) / rows;
+    int remain = frameCount;
+    for(int row=0; row<rows; row++){
+        int columns = qCeil(double(remain) / (rows - row));
+        remain -= columns;
+        double top = margin + row * (rowHeight + rowGutter);
+        double gutter = calcGutter(length, columns);
+        double width = length - gutter * (columns - 1);
+
+        //!各コマの幅は、均等割りから前後させる
+        QVector<double> weight;
+        double total = 0;
+        for(int i=0; i<columns; i++){
+            weight.push_back(random.real(0.6, 1.4));
+            total += weight.last();
+        }
+        double left = margin;
+        for(int i=0; i<columns; i++){
+            double w = width * weight.at(i) / total;
+            frames.push_back(QRectF(left, top, w, rowHeight));
+            left += w + gutter;
+        }
+    }
+    return frames;
+}
+
+/*!
+ * \brief コマ以外の注釈の配置先を決める
+ * \param frameRect コマの矩形
+ * \param minScale コマに対する最小の大きさ
+ * \param maxScale コマに対する最大の大きさ
+ * \param area 配置先の矩形の格納先
+ * \return 対象とするコマの番号（1から、コマが無い場合0）
+ */
+int placeAnnotation(SyntheticRandom &random, const QVector<QRectF> &frameRect,
+                    double minScale, double maxScale, QRectF &area)
+{
+    if(frameRect.isEmpty()){
+        area = createSyntheticRect(random, QRectF(0, 0, 1, 1), minScale, maxScale);
+        return 0;
+    }
+    int targetFrame = random.integer(1, frameRect.size());
+    area = createSyntheticRect(random, frameRect.at(targetFrame - 1), minScale, maxScale);
+    return targetFrame;
+}
+
+} // namespace
+
+SyntheticPageSpec::SyntheticPageSpec()
+{
+    imageWidth = 1500;
+    imageHeight = 1060;
+    frameCount = 6;
+    characterCount = 4;
+    dialogCount = 8;
+    onomatopoeiaCount = 2;
+    itemCount = 2;
+    minVertexCount = 4;
+    maxVertexCount = 8;
+}
+
+void SyntheticPageSpec::setAnnotationCount(int annotationCount)
+{
+    int count = qMax(1, annotationCount);
+    frameCount = (count + 4) / 5;
+    int rest = count - frameCount;
+    characterCount = (rest + 3) / 4;
+    dialogCount = (rest + 2) / 4;
+    onomatopoeiaCount = (rest + 1) / 4;
+    itemCount = rest / 4;
+}
+
+int SyntheticPageSpec::annotationCount() const
+{
+    return frameCount + characterCount + dialogCount + onomatopoeiaCount + itemCount;
+}
+
+void createSyntheticCommon(ComicMetadata &metadata, QString workTitle, int castCount)
+{
+    metadata.clear();
+    metadata.workTitle = workTitle;
+    for(int i=0; i<castCount; i++){
+        metadata.characterName.push_back(QString("Character%1").arg(i+1, 3, 10, QChar('0')));
+    }
+}
+
+void createSyntheticPage(ComicMetadata &metadata, const SyntheticPageSpec &spec,
+                         int episodeNumber, int pageNumber, quint32 seed)
+{
+    SyntheticRandom random(seed);
+    int width = spec.imageWidth;
+    int height = spec.imageHeight;
+    int minVertex = qMax(3, spec.minVertexCount);
+    int maxVertex = qMax(minVertex, spec.maxVertexCount);
+    int castCount = metadata.characterName.size();
+
+    metadata.clearPageMetadata();
+    metadata.episodeNumber = episodeNumber;
+    metadata.pageNumber = pageNumber;
+    metadata.imageFileName = QString("%1.jpg").arg(pageNumber, 4, 10, QChar('0'));
+    metadata.imageWidth = width;
+    metadata.imageHeight = height;
+
+    //!コマ（コマが無い場合、他の注釈はページ全体に配置し対象のコマ無しとする）
+    QVector<QRectF> frameRect = layoutFrames(random, spec.frameCount);
+    for(int i=0; i<frameRect.size(); i++){
+        FrameData data;
+        data.sceneBoundary = (i == 0 || random.integer(0, 9) == 0);
+        QPolygonF polygon = createRectangularPolygon(frameRect.at(i), random.integer(minVertex, maxVertex));
+        data.GIData.setRelativePolygon(polygon, width, height);
+        metadata.frame.data()->push_back(data);
+    }
+
+    //!その他の注釈は、対象のコマの内側に配置する
+    QRectF area;
+    for(int i=0; i<spec.characterCount; i++){
+        CharacterData data;
+        data.targetFrame = placeAnnotation(random, frameRect, 0.3, 0.7, area);
+        data.characterID = castCount > 0 ? random.integer(0, castCount - 1) : -1;
+        if(data.characterID >= 0) data.characterName = metadata.characterName.at(data.characterID);
+        QPolygonF polygon = createSyntheticPolygon(random, area, random.integer(minVertex, maxVertex));
+        data.GIData.setRelativePolygon(polygon, width, height);
+        metadata.character.data()->push_back(data);
+    }
+    for(int i=0; i<spec.dialogCount; i++){
+        DialogData data;
+        data.targetFrame = placeAnnotation(random, frameRect, 0.2, 0.4, area);
+        data.text = QString::fromUtf8(DIALOG_PHRASE[random.integer(0, arraySize(DIALOG_PHRASE) - 1)]);
+        data.fontSize = random.integer(1, 5);
+        data.narration = (castCount == 0 || random.integer(0, 9) == 0);
+        data.targetCharacterID = data.narration ? -1 : random.integer(0, castCount - 1);
+        if(!data.narration) data.characterName = metadata.characterName.at(data.targetCharacterID);
+        QPolygonF polygon = createSyntheticPolygon(random, area, random.integer(minVertex, maxVertex));
+        data.GIData.setRelativePolygon(polygon, width, height);
+        metadata.dialog.data()->push_back(data);
+    }
+    for(int i=0; i<spec.onomatopoeiaCount; i++){
+        OnomatopoeiaData data;
+        data.targetFrame = placeAnnotation(random, frameRect, 0.15, 0.35, area);
+        data.setText(QString::fromUtf8(ONOMATOPOEIA_TEXT[random.integer(0, arraySize(ONOMATOPOEIA_TEXT) - 1)]));
+        data.fontSize = random.integer(1, 5);
+        QPolygonF polygon = createSyntheticPolygon(random, area, random.integer(minVertex, maxVertex));
+        data.GIData.setRelativePolygon(polygon, width, height);
+        metadata.onomatopoeia.data()->push_back(data);
+    }
+    for(int i=0; i<spec.itemCount; i++){
+        ItemData data;
+        data.targetFrame = placeAnnotation(random, frameRect, 0.1, 0.3, area);
+        data.itemClass = ITEM_CLASS[random.integer(0, arraySize(ITEM_CLASS) - 1)];
+        data.description = QString("%1 %2").arg(data.itemClass).arg(i + 1);
+        QPolygonF polygon = createSyntheticPolygon(random, area, random.integer(minVertex, maxVertex));
+        data.GIData.setRelativePolygon(polygon, width, height);
+        metadata.item.data()->push_back(data);
+    }
+}
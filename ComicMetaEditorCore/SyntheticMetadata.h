@@ -0,0 +1,90 @@
+﻿/*! \file
+ *  \brief 負荷試験・ベンチマーク用の合成メタデータ生成
+ *  \date 2026/10/17 新規作成
+ */
+
+#ifndef SYNTHETICMETADATA_H
+#define SYNTHETICMETADATA_H
+
+#include "ComicMetadata.h"
+#include <QPolygonF>
+#include <QRectF>
+#include <random>
+
+/*!
+ * \brief 処理系によらず、同じシードから常に同じ列を生成する乱数生成器
+ * std::uniform_int_distribution等の分布クラスはアルゴリズムが処理系定義であり、
+ * 同じシードでも標準ライブラリにより生成内容が変わるため、mt19937の出力から直接求める
+ */
+class SyntheticRandom
+{
+public:
+    explicit SyntheticRandom(quint32 seed);
+    int integer(int min, int max); //!<min以上max以下の整数を一様に生成する
+    double real(double min, double max); //!<min以上max未満の実数を一様に生成する
+private:
+    std::mt19937 _engine;
+};
+
+/*!
+ * \brief 矩形に内接する楕円に近い凸ポリゴンを生成する（コマ以外の注釈用）
+ * \param random 乱数生成器
+ * \param rect 外形の矩形
+ * \param vertexCount 頂点数（3以上）
+ */
+QPolygonF createSyntheticPolygon(SyntheticRandom &random, QRectF rect, int vertexCount);
+
+/*!
+ * \brief 範囲内に収まる矩形をランダムに生成する
+ * \param random 乱数生成器
+ * \param area 範囲
+ * \param minScale 範囲に対する最小の大きさ
+ * \param maxScale 範囲に対する最大の大きさ
+ */
+QRectF createSyntheticRect(SyntheticRandom &random, QRectF area, double minScale, double maxScale);
+
+/*!
+ * \brief 合成するページの条件
+ */
+class SyntheticPageSpec
+{
+public:
+    SyntheticPageSpec();
+    int imageWidth; //!<画像の幅
+    int imageHeight; //!<画像の高さ
+    int frameCount; //!<コマ数（他の注釈はいずれかのコマを対象とする）
+    int characterCount; //!<登場人物の数
+    int dialogCount; //!<セリフの数
+    int onomatopoeiaCount; //!<オノマトペの数
+    int itemCount; //!<アイテムの数
+    int minVertexCount; //!<ポリゴンの最小頂点数（3以上）
+    int maxVertexCount; //!<ポリゴンの最大頂点数
+
+    //! 注釈の総数を、コマ・登場人物・セリフ・オノマトペ・アイテムに均等に振り分ける
+    void setAnnotationCount(int annotationCount);
+    int annotationCount() const; //!<注釈の総数
+};
+
+/*!
+ * \brief 複数ページ共通のメタデータ（作品名、登場人物リスト）を生成する
+ * \param metadata 生成先（内容は全て消去される）
+ * \param workTitle 作品名
+ * \param castCount 登場人物リストの人数
+ */
+void createSyntheticCommon(ComicMetadata &metadata, QString workTitle, int castCount);
+
+/*!
+ * \brief ページメタデータを生成する
+ * コマはページを行単位に分割して配置し、その他の注釈は対象のコマの内側に配置する。
+ * 同じ条件・シードからは常に同じ内容が生成される。\n
+ * 作品名と登場人物リストはmetadataに設定済みのものを使用する（createSyntheticCommon）
+ * \param metadata 生成先（ページメタデータは全て置き換えられる）
+ * \param spec 生成条件
+ * \param episodeNumber 話数
+ * \param pageNumber ページ番号（画像ファイル名にも使用する）
+ * \param seed 乱数シード
+ */
+void createSyntheticPage(ComicMetadata &metadata, const SyntheticPageSpec &spec,
+                         int episodeNumber, int pageNumber, quint32 seed);
+
+#endif // SYNTHETICMETADATA_H
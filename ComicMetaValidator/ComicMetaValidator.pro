@@ -0,0 +1,21 @@
+#-------------------------------------------------
+#
+# メタデータコーパスの一括検証用コマンドラインツール
+#
+#-------------------------------------------------
+
+QT       = core gui concurrent
+
+TARGET = ComicMetaValidator
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+
+include(../ComicMetaEditorCore/ComicMetaEditorCore.pri)
+
+SOURCES +=\
+    Main.cpp \
+    MetadataValidator.cpp
+
+HEADERS  += \
+    MetadataValidator.h
@@ -0,0 +1,122 @@
+﻿/*!
+ * \file
+ * \brief メタデータコーパス一括検証ツール 実行用
+ * \date 2026/10/17 新規作成
+ *
+ * 使い方: ComicMetaValidator [-j スレッド数] [-q] ディレクトリ...\n
+ * 指定されたディレクトリ以下の全てのメタデータファイル（*.xml）を全コアで並列に検証し、
+ * 問題点と処理速度（pages/s, MB/s）を出力する。問題が有った場合は終了コード1を返す
+ */
+#include "MetadataValidator.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QThreadPool>
+#include <QtConcurrentMap>
+#include <iostream>
+
+using namespace std;
+
+static const char *COMMON_METADATA_FILE_NAME = "ComicMetadata.xml";
+
+/*!
+ * \brief 検証結果の問題点を出力する
+ * \return 問題が有った場合true
+ */
+static bool printErrors(const ValidationResult &result)
+{
+    for(int i=0; i<result.errors.size(); i++){
+        cout << result.fileName.toStdString() << ": " << result.errors.at(i).toStdString() << endl;
+    }
+    return !result.errors.isEmpty();
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("ComicMetaValidator");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Validates ComicMetaEditor metadata files under the given directories.");
+    parser.addHelpOption();
+    QCommandLineOption jobsOption(QStringList() << "j" << "jobs",
+                                  "Number of worker threads (default: all cores).", "n");
+    QCommandLineOption quietOption(QStringList() << "q" << "quiet",
+                                   "Print only the summary.");
+    parser.addOption(jobsOption);
+    parser.addOption(quietOption);
+    parser.addPositionalArgument("directories", "Directories to scan recursively.", "<directory>...");
+    parser.process(app);
+
+    QStringList directories = parser.positionalArguments();
+    if(directories.isEmpty()){
+        parser.showHelp(1);
+    }
+    if(parser.isSet(jobsOption)){
+        int jobs = parser.value(jobsOption).toInt();
+        if(jobs > 0) QThreadPool::globalInstance()->setMaxThreadCount(jobs);
+    }
+    bool quiet = parser.isSet(quietOption);
+
+    //!- 検証対象のファイルを集める
+    QStringList commonFiles;
+    QStringList pageFiles;
+    for(int i=0; i<directories.size(); i++){
+        QDirIterator it(directories.at(i), QStringList() << "*.xml", QDir::Files,
+                        QDirIterator::Subdirectories | QDirIterator::FollowSymlinks);
+        while(it.hasNext()){
+            QString fileName = QFileInfo(it.next()).absoluteFilePath();
+            if(0 == QString::compare(it.fileName(), COMMON_METADATA_FILE_NAME, Qt::CaseInsensitive)){
+                commonFiles << fileName;
+            }
+            else{
+                pageFiles << fileName;
+            }
+        }
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    qint64 totalBytes = 0;
+    int errorFileCount = 0;
+
+    //!- 共通メタデータを検証し、ディレクトリ毎の登場人物数を求める
+    QHash<QString, int> characterCount;
+    for(int i=0; i<commonFiles.size(); i++){
+        int count;
+        ValidationResult result = validateCommonMetadata(commonFiles.at(i), &count);
+        totalBytes += result.bytes;
+        if(count >= 0) characterCount.insert(QFileInfo(commonFiles.at(i)).absolutePath(), count);
+        if(!result.errors.isEmpty()){
+            errorFileCount++;
+            if(!quiet) printErrors(result);
+        }
+    }
+
+    //!- ページメタデータを全コアで並列に検証する
+    QList<ValidationResult> results =
+            QtConcurrent::blockingMapped(pageFiles, PageValidator(&characterCount));
+    double seconds = timer.nsecsElapsed() / 1e9;
+
+    for(int i=0; i<results.size(); i++){
+        const ValidationResult &result = results.at(i);
+        totalBytes += result.bytes;
+        if(!result.errors.isEmpty()){
+            errorFileCount++;
+            if(!quiet) printErrors(result);
+        }
+    }
+
+    //!- 処理速度を出力する
+    double megaBytes = totalBytes / (1024.0 * 1024.0);
+    if(seconds <= 0) seconds = 1e-9;
+    cout << "files       : " << commonFiles.size() << " common, " << pageFiles.size() << " pages" << endl;
+    cout << "errors      : " << errorFileCount << " file(s)" << endl;
+    cout << "threads     : " << QThreadPool::globalInstance()->maxThreadCount() << endl;
+    cout << "elapsed     : " << seconds << " s" << endl;
+    cout << "throughput  : " << pageFiles.size() / seconds << " pages/s, "
+         << megaBytes / seconds << " MB/s (" << megaBytes << " MB)" << endl;
+
+    return errorFileCount > 0 ? 1 : 0;
+}
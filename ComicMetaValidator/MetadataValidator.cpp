@@ -0,0 +1,147 @@
+﻿/*! \file
+ *  \brief メタデータファイルの検証処理 実装部
+ *  \date 2026/10/17 新規作成
+ */
+
+#include "MetadataValidator.h"
+#include <QFile>
+#include <QFileInfo>
+
+//! 相対座標の範囲判定の許容誤差（出力時の丸めを考慮する）
+static const double COORDINATE_TOLERANCE = 1e-4;
+
+ValidationResult::ValidationResult()
+{
+    bytes = 0;
+}
+
+/*!
+ * \brief 枠の座標を検証する
+ */
+static void checkCoordinate(const QPolygonF &polygon, QString label, QStringList &errors)
+{
+    if(polygon.size() < 3){
+        errors << QString("%1: coordinate has %2 point(s)").arg(label).arg(polygon.size());
+    }
+    for(int i=0; i<polygon.size(); i++){
+        const QPointF &pt = polygon.at(i);
+        if(pt.x() < -COORDINATE_TOLERANCE || pt.x() > 1.0 + COORDINATE_TOLERANCE
+                || pt.y() < -COORDINATE_TOLERANCE || pt.y() > 1.0 + COORDINATE_TOLERANCE){
+            errors << QString("%1: point %2 (%3, %4) is out of the image")
+                      .arg(label).arg(i+1).arg(pt.x()).arg(pt.y());
+            break;
+        }
+    }
+}
+
+/*!
+ * \brief 対象コマの番号を検証する（0はDefault、1以降がコマ）
+ */
+static void checkTargetFrame(int targetFrame, int frameCount, QString label, QStringList &errors)
+{
+    if(targetFrame < 0 || targetFrame > frameCount){
+        errors << QString("%1: target frame %2 is out of range (0-%3)")
+                  .arg(label).arg(targetFrame).arg(frameCount);
+    }
+}
+
+/*!
+ * \brief 登場人物IDを検証する（characterCountが負の場合は登場人物リスト無しとして検証しない）
+ */
+static void checkCharacterID(int characterID, int characterCount, QString label, QStringList &errors)
+{
+    if(characterCount < 0) return;
+    if(characterID < 0 || characterID >= characterCount){
+        errors << QString("%1: character ID %2 is out of range (0-%3)")
+                  .arg(label).arg(characterID).arg(characterCount - 1);
+    }
+}
+
+static void checkFontSize(int fontSize, QString label, QStringList &errors)
+{
+    if(fontSize < 1 || fontSize > 5){
+        errors << QString("%1: font size %2 is out of range (1-5)").arg(label).arg(fontSize);
+    }
+}
+
+ValidationResult validateCommonMetadata(QString fileName, int *characterCount)
+{
+    ValidationResult result;
+    result.fileName = fileName;
+    result.bytes = QFileInfo(fileName).size();
+
+    ComicMetadata metadata;
+    if(!metadata.loadMetadata_Common(fileName)){
+        result.errors << "not a readable ComicMetadata XML file";
+        if(characterCount) *characterCount = -1;
+        return result;
+    }
+    if(characterCount) *characterCount = metadata.characterName.size();
+    return result;
+}
+
+PageValidator::PageValidator(const QHash<QString, int> *characterCount)
+{
+    _characterCount = characterCount;
+}
+
+ValidationResult PageValidator::operator()(const QString &fileName) const
+{
+    ValidationResult result;
+    result.fileName = fileName;
+
+    QFile file(fileName);
+    if(!file.open(QFile::ReadOnly)){
+        result.errors << "cannot open the file";
+        return result;
+    }
+    result.bytes = file.size();
+
+    //!- XMLとして読み込む
+    ComicMetadata metadata;
+    if(!metadata.loadMetadata_Page(&file)){
+        result.errors << "not a readable ComicMetadata XML file";
+        return result;
+    }
+    if(metadata.loadImageFileName.isEmpty()){
+        result.errors << "PageData/FileName is missing";
+    }
+
+    //!- 各メタデータの内容を検証する
+    int frameCount = metadata.loadFrame.size();
+    int characterCount = _characterCount->value(QFileInfo(fileName).absolutePath(), -1);
+    QStringList &errors = result.errors;
+    for(int i=0; i<metadata.loadFrameCoordinate.size(); i++){
+        checkCoordinate(metadata.loadFrameCoordinate.at(i), QString("Frame %1").arg(i+1), errors);
+    }
+    for(int i=0; i<metadata.loadCharacter.size(); i++){
+        QString label = QString("Character %1").arg(i+1);
+        const CharacterData &data = metadata.loadCharacter.at(i);
+        checkCharacterID(data.characterID, characterCount, label, errors);
+        checkTargetFrame(data.targetFrame, frameCount, label, errors);
+        checkCoordinate(metadata.loadCharacterCoordinate.at(i), label, errors);
+    }
+    for(int i=0; i<metadata.loadDialog.size(); i++){
+        QString label = QString("Dialog %1").arg(i+1);
+        const DialogData &data = metadata.loadDialog.at(i);
+        if(!data.narration){
+            checkCharacterID(data.targetCharacterID, characterCount, label, errors);
+        }
+        checkFontSize(data.fontSize, label, errors);
+        checkTargetFrame(data.targetFrame, frameCount, label, errors);
+        checkCoordinate(metadata.loadDialogCoordinate.at(i), label, errors);
+    }
+    for(int i=0; i<metadata.loadOnomatopoeia.size(); i++){
+        QString label = QString("Onomatopoeia %1").arg(i+1);
+        const OnomatopoeiaData &data = metadata.loadOnomatopoeia.at(i);
+        checkFontSize(data.fontSize, label, errors);
+        checkTargetFrame(data.targetFrame, frameCount, label, errors);
+        checkCoordinate(metadata.loadOnomatopoeiaCoordinate.at(i), label, errors);
+    }
+    for(int i=0; i<metadata.loadItem.size(); i++){
+        QString label = QString("Item %1").arg(i+1);
+        checkTargetFrame(metadata.loadItem.at(i).targetFrame, frameCount, label, errors);
+        checkCoordinate(metadata.loadItemCoordinate.at(i), label, errors);
+    }
+    return result;
+}
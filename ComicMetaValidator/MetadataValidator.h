@@ -0,0 +1,62 @@
+﻿/*! \file
+ *  \brief メタデータファイルの検証処理
+ *  \date 2026/10/17 新規作成
+ */
+
+#ifndef METADATAVALIDATOR_H
+#define METADATAVALIDATOR_H
+
+#include "ComicMetadata.h"
+#include <QString>
+#include <QStringList>
+#include <QHash>
+
+/*!
+ * \brief 1ファイル分の検証結果
+ */
+class ValidationResult
+{
+public:
+    ValidationResult();
+    QString fileName; //!< 検証したファイル名
+    qint64 bytes; //!< ファイルサイズ
+    QStringList errors; //!< 検出した問題（問題が無ければ空）
+};
+
+/*!
+ * \brief 共通メタデータ（ComicMetadata.xml）を検証する
+ * \param fileName 共通メタデータファイル名
+ * \param characterCount 登場人物リストの人数の格納先
+ * \return 検証結果
+ */
+ValidationResult validateCommonMetadata(QString fileName, int *characterCount);
+
+/*!
+ * \brief ページメタデータの検証用関数オブジェクト
+ * QtConcurrent::mappedで複数スレッドから同時に呼び出される。\n
+ * 以下の項目を検証する
+ * - XMLとして読み込めること、ComicMetadata/PageDataの構造を持つこと
+ * - 各枠の座標が3点以上あり、画像に対する相対座標（0～1）の範囲内であること
+ * - 対象コマ（targetFrame）が0（Default）～コマ数の範囲内であること
+ * - 登場人物ID、話者IDが同じディレクトリの登場人物リストの範囲内であること
+ * - フォントサイズが1～5であること
+ */
+class PageValidator
+{
+public:
+    typedef ValidationResult result_type;
+
+    /*!
+     * \brief コンストラクタ
+     * \param characterCount メタデータディレクトリの絶対パスをキーとした登場人物リストの人数
+     * （共通メタデータが無いディレクトリは含まない）
+     */
+    PageValidator(const QHash<QString, int> *characterCount);
+
+    ValidationResult operator()(const QString &fileName) const;
+
+private:
+    const QHash<QString, int> *_characterCount;
+};
+
+#endif // METADATAVALIDATOR_H